@@ -0,0 +1,143 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "Arena.h"
+
+#define ARENA_ALIGN(size) (((size) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+#define ARENA_BLOCK_HEADER_SIZE ARENA_ALIGN(sizeof(ArenaBlock))
+
+static ArenaBlock *AddArenaBlock(Arena *arena, size_t minSize)
+{
+    size_t size = minSize > ARENA_DEFAULT_BLOCK_SIZE ? minSize : ARENA_DEFAULT_BLOCK_SIZE;
+
+    ArenaBlock *block = malloc(ARENA_BLOCK_HEADER_SIZE + size);
+    if (!block)
+    {
+        arena->hasFailed = true;
+        return NULL;
+    }
+    block->size = size;
+    block->used = 0;
+
+    // Kept after the current block so blocks left over from before a reset are still reused in order
+    if (arena->current)
+    {
+        block->next = arena->current->next;
+        arena->current->next = block;
+    }
+    else
+    {
+        block->next = arena->first;
+        arena->first = block;
+    }
+
+    return block;
+}
+
+void *ArenaAlloc(Arena *arena, size_t size)
+{
+    size = ARENA_ALIGN(size == 0 ? 1 : size);
+
+    ArenaBlock *block = arena->current;
+    while (block && block->size - block->used < size)
+    {
+        block = block->next;
+        if (block)
+        {
+            block->used = 0;
+        }
+    }
+
+    if (!block)
+    {
+        block = AddArenaBlock(arena, size);
+        if (!block)
+        {
+            return NULL;
+        }
+    }
+
+    arena->current = block;
+
+    void *ptr = (unsigned char *)block + ARENA_BLOCK_HEADER_SIZE + block->used;
+    block->used += size;
+    return ptr;
+}
+
+void *ArenaCalloc(Arena *arena, size_t count, size_t size)
+{
+    if (size != 0 && count > (size_t)-1 / size)
+    {
+        arena->hasFailed = true;
+        return NULL;
+    }
+
+    void *ptr = ArenaAlloc(arena, count * size);
+    if (ptr)
+    {
+        memset(ptr, 0, count * size);
+    }
+    return ptr;
+}
+
+char *ArenaFormat(Arena *arena, size_t max_size, const char *format, ...)
+{
+    static char empty[1] = "";
+
+    if (!format || max_size == 0)
+    {
+        return empty;
+    }
+
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+
+    if (length < 0)
+    {
+        return empty;
+    }
+
+    size_t size = (size_t)length + 1 < max_size ? (size_t)length + 1 : max_size;
+
+    char *str = ArenaAlloc(arena, size);
+    if (!str)
+    {
+        return empty;
+    }
+
+    va_start(args, format);
+    vsnprintf(str, size, format, args);
+    va_end(args);
+
+    return str;
+}
+
+void ResetArena(Arena *arena)
+{
+    if (arena->first)
+    {
+        arena->first->used = 0;
+    }
+    arena->current = arena->first;
+    arena->hasFailed = false;
+}
+
+void FreeArena(Arena *arena)
+{
+    ArenaBlock *block = arena->first;
+    while (block)
+    {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->hasFailed = false;
+}
@@ -0,0 +1,44 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#ifdef RAPID_HEADLESS
+#include "Headless.h"
+#endif
+
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGNMENT 16
+
+typedef struct ArenaBlock
+{
+    struct ArenaBlock *next;
+    size_t size;
+    size_t used;
+} ArenaBlock;
+
+// Bump allocator made of chained blocks. Nothing is freed on its own, ResetArena releases everything at once
+// and keeps the blocks for the next use
+typedef struct
+{
+    ArenaBlock *first;
+    ArenaBlock *current;
+
+    // Set when a block could not be allocated, cleared by ResetArena
+    bool hasFailed;
+} Arena;
+
+void *ArenaAlloc(Arena *arena, size_t size);
+
+void *ArenaCalloc(Arena *arena, size_t count, size_t size);
+
+// Like strmac with a NULL buffer, but the result is only as long as the formatted text, at most max_size including the terminator.
+// Returns an empty string if the arena is out of memory
+char *ArenaFormat(Arena *arena, size_t max_size, const char *format, ...);
+
+void ResetArena(Arena *arena);
+
+void FreeArena(Arena *arena);
@@ -0,0 +1,138 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#include "AssetPreload.h"
+
+#ifdef _WIN32
+#define INFINITE 0xFFFFFFFFUL
+#define ALL_PROCESSOR_GROUPS 0xFFFF
+
+void *__stdcall CreateThread(void *lpThreadAttributes, size_t dwStackSize, unsigned long(__stdcall *lpStartAddress)(void *), void *lpParameter, unsigned long dwCreationFlags, unsigned long *lpThreadId);
+unsigned long __stdcall WaitForSingleObject(void *hHandle, unsigned long dwMilliseconds);
+unsigned long __stdcall GetActiveProcessorCount(unsigned short GroupNumber);
+int __stdcall CloseHandle(void *hObject);
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+typedef struct
+{
+    AssetPreload *assets;
+    int count;
+    int first;
+    int stride;
+} AssetWorker;
+
+static void DecodeAsset(AssetPreload *asset)
+{
+    switch (asset->kind)
+    {
+    case ASSET_IMAGE:
+        asset->image = LoadImage(asset->path);
+        asset->isDecoded = asset->image.width > 0 && asset->image.height > 0;
+        break;
+    case ASSET_WAVE:
+        asset->wave = LoadWave(asset->path);
+        asset->isDecoded = asset->wave.frameCount > 0 && asset->wave.sampleRate > 0;
+        break;
+    }
+}
+
+// Workers take every stride-th asset, so no two touch the same one and nothing has to be locked
+static void RunAssetWorker(AssetWorker *worker)
+{
+    for (int i = worker->first; i < worker->count; i += worker->stride)
+    {
+        DecodeAsset(&worker->assets[i]);
+    }
+}
+
+#ifdef _WIN32
+static unsigned long __stdcall AssetWorkerThread(void *arg)
+{
+    RunAssetWorker(arg);
+    return 0;
+}
+#else
+static void *AssetWorkerThread(void *arg)
+{
+    RunAssetWorker(arg);
+    return NULL;
+}
+#endif
+
+static int GetCoreCount(void)
+{
+#ifdef _WIN32
+    int cores = (int)GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+#else
+    int cores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return cores > 0 ? cores : 1;
+}
+
+int DecodeAssets(AssetPreload *assets, int count)
+{
+    if (count <= 0)
+    {
+        return 0;
+    }
+
+    int threadCount = GetCoreCount();
+    if (threadCount > MAX_PRELOAD_THREADS)
+    {
+        threadCount = MAX_PRELOAD_THREADS;
+    }
+    if (threadCount > count)
+    {
+        threadCount = count;
+    }
+
+    AssetWorker workers[MAX_PRELOAD_THREADS];
+#ifdef _WIN32
+    void *threads[MAX_PRELOAD_THREADS];
+#else
+    pthread_t threads[MAX_PRELOAD_THREADS];
+#endif
+    bool isStarted[MAX_PRELOAD_THREADS] = {0};
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers[i] = (AssetWorker){.assets = assets, .count = count, .first = i, .stride = threadCount};
+    }
+
+    // The calling thread takes the first share instead of waiting idle
+    for (int i = 1; i < threadCount; i++)
+    {
+#ifdef _WIN32
+        threads[i] = CreateThread(NULL, 0, AssetWorkerThread, &workers[i], 0, NULL);
+        isStarted[i] = threads[i] != NULL;
+#else
+        isStarted[i] = pthread_create(&threads[i], NULL, AssetWorkerThread, &workers[i]) == 0;
+#endif
+    }
+
+    RunAssetWorker(&workers[0]);
+
+    int threadsUsed = 1;
+    for (int i = 1; i < threadCount; i++)
+    {
+        if (!isStarted[i])
+        {
+            // Out of threads, the share is decoded here instead
+            RunAssetWorker(&workers[i]);
+            continue;
+        }
+
+#ifdef _WIN32
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#else
+        pthread_join(threads[i], NULL);
+#endif
+        threadsUsed++;
+    }
+
+    return threadsUsed;
+}
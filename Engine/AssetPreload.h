@@ -0,0 +1,35 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "raylib.h"
+
+#ifdef RAPID_HEADLESS
+#include "Headless.h"
+#endif
+
+#define MAX_PRELOAD_THREADS 16
+
+typedef enum
+{
+    ASSET_IMAGE,
+    ASSET_WAVE
+} AssetKind;
+
+typedef struct
+{
+    AssetKind kind;
+    const char *path;
+
+    // Filled by DecodeAssets, only the member matching kind is used
+    Image image;
+    Wave wave;
+    bool isDecoded;
+} AssetPreload;
+
+// Decodes every asset into CPU memory, spread over one worker thread per core. Nothing here touches the GPU
+// or the audio device, so the results still have to be uploaded on the main thread. Returns the thread count used
+int DecodeAssets(AssetPreload *assets, int count);
@@ -0,0 +1,768 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#include "Interpreter.h"
+
+#define INVALID_PC -1
+#define SHARED_RET_PC 0
+
+typedef struct
+{
+    int pc;
+    int operand;
+    int nodeIndex;
+} PendingTarget;
+
+typedef struct
+{
+    InterpreterContext *intp;
+    RuntimeGraphContext *graph;
+    BytecodeProgram *program;
+
+    PendingTarget *pending;
+    int pendingCount;
+    int pendingCapacity;
+
+    bool outOfMemory;
+} BytecodeCompiler;
+
+void FreeBytecodeProgram(BytecodeProgram *program)
+{
+    if (!program)
+    {
+        return;
+    }
+
+    free(program->code);
+    free(program->entryByNode);
+    free(program->pcByNode);
+    free(program->loopSteps);
+    free(program->callStack);
+
+    *program = (BytecodeProgram){0};
+}
+
+static int Emit(BytecodeCompiler *compiler, OpCode op, int a, int b, int c, int d)
+{
+    BytecodeProgram *program = compiler->program;
+
+    if (compiler->outOfMemory)
+    {
+        return INVALID_PC;
+    }
+
+    if (program->codeCount >= program->codeCapacity)
+    {
+        int newCapacity = program->codeCapacity == 0 ? BYTECODE_INITIAL_CODE_CAPACITY : program->codeCapacity * 2;
+        Instruction *newCode = realloc(program->code, sizeof(Instruction) * newCapacity);
+        if (!newCode)
+        {
+            compiler->outOfMemory = true;
+            return INVALID_PC;
+        }
+        program->code = newCode;
+        program->codeCapacity = newCapacity;
+    }
+
+    program->code[program->codeCount] = (Instruction){op, a, b, c, d};
+    return program->codeCount++;
+}
+
+static int *GetInstructionOperand(Instruction *instruction, int operand)
+{
+    switch (operand)
+    {
+    case 0:
+        return &instruction->a;
+    case 1:
+        return &instruction->b;
+    case 2:
+        return &instruction->c;
+    default:
+        return &instruction->d;
+    }
+}
+
+static int GetNextNodeIndex(RuntimeGraphContext *graph, int nodeIndex, int outFlowPinIndexInNode)
+{
+    RuntimeNode *node = &graph->nodes[nodeIndex];
+    if (outFlowPinIndexInNode >= node->outputCount || !node->outputPins[outFlowPinIndexInNode])
+    {
+        return -1;
+    }
+
+    int next = node->outputPins[outFlowPinIndexInNode]->nextNodeIndex;
+    if (next < 0 || next >= graph->nodeCount)
+    {
+        return -1;
+    }
+
+    return next;
+}
+
+static int GetInputSlot(RuntimeNode *node, int pinIndexInNode)
+{
+    if (pinIndexInNode >= node->inputCount || !node->inputPins[pinIndexInNode])
+    {
+        return -1;
+    }
+    return node->inputPins[pinIndexInNode]->valueIndex;
+}
+
+static int GetOutputSlot(RuntimeNode *node, int pinIndexInNode)
+{
+    if (pinIndexInNode >= node->outputCount || !node->outputPins[pinIndexInNode])
+    {
+        return -1;
+    }
+    return node->outputPins[pinIndexInNode]->valueIndex;
+}
+
+static int GetPickedOption(RuntimeNode *node, int pinIndexInNode)
+{
+    if (pinIndexInNode >= node->inputCount || !node->inputPins[pinIndexInNode])
+    {
+        return -1;
+    }
+    return node->inputPins[pinIndexInNode]->pickedOption;
+}
+
+// Chains that are not compiled yet are queued, so nested flow never recurses in the compiler
+static void EmitTarget(BytecodeCompiler *compiler, int pc, int operand, int nodeIndex)
+{
+    BytecodeProgram *program = compiler->program;
+
+    if (pc == INVALID_PC)
+    {
+        return;
+    }
+
+    if (nodeIndex < 0)
+    {
+        *GetInstructionOperand(&program->code[pc], operand) = SHARED_RET_PC;
+        return;
+    }
+
+    if (program->pcByNode[nodeIndex] != INVALID_PC)
+    {
+        *GetInstructionOperand(&program->code[pc], operand) = program->pcByNode[nodeIndex];
+        return;
+    }
+
+    if (compiler->pendingCount >= compiler->pendingCapacity)
+    {
+        int newCapacity = compiler->pendingCapacity == 0 ? 16 : compiler->pendingCapacity * 2;
+        PendingTarget *newPending = realloc(compiler->pending, sizeof(PendingTarget) * newCapacity);
+        if (!newPending)
+        {
+            compiler->outOfMemory = true;
+            return;
+        }
+        compiler->pending = newPending;
+        compiler->pendingCapacity = newCapacity;
+    }
+
+    compiler->pending[compiler->pendingCount++] = (PendingTarget){pc, operand, nodeIndex};
+}
+
+static void CompileNode(BytecodeCompiler *compiler, RuntimeNode *node)
+{
+    Value *values = compiler->intp->values;
+
+    switch (node->type)
+    {
+    case NODE_CREATE_NUMBER:
+    case NODE_CREATE_STRING:
+    case NODE_CREATE_BOOL:
+    case NODE_CREATE_COLOR:
+    {
+        int dst = GetOutputSlot(node, 1);
+        int src = GetInputSlot(node, 1);
+        if (dst == -1 || src == -1)
+        {
+            break;
+        }
+
+        OpCode op = OP_COPY_NUMBER;
+        if (node->type == NODE_CREATE_STRING)
+        {
+            op = OP_COPY_STRING;
+        }
+        else if (node->type == NODE_CREATE_BOOL)
+        {
+            op = OP_COPY_BOOL;
+        }
+        else if (node->type == NODE_CREATE_COLOR)
+        {
+            op = OP_COPY_COLOR;
+        }
+
+        Emit(compiler, op, dst, src, 0, 0);
+        return;
+    }
+
+    case NODE_SET_VARIABLE:
+    {
+        int dst = GetOutputSlot(node, 1);
+        int src = GetInputSlot(node, 2);
+        if (dst == -1 || src == -1)
+        {
+            break;
+        }
+
+        switch (values[dst].type)
+        {
+        case VAL_NUMBER:
+            Emit(compiler, OP_COPY_NUMBER, dst, src, 0, 0);
+            return;
+        case VAL_STRING:
+            Emit(compiler, OP_COPY_STRING, dst, src, 0, 0);
+            return;
+        case VAL_BOOL:
+            Emit(compiler, OP_COPY_BOOL, dst, src, 0, 0);
+            return;
+        case VAL_COLOR:
+            Emit(compiler, OP_COPY_COLOR, dst, src, 0, 0);
+            return;
+        default:
+            break;
+        }
+        break;
+    }
+
+    case NODE_COMPARISON:
+    case NODE_GATE:
+    case NODE_ARITHMETIC:
+    {
+        int dst = GetOutputSlot(node, 1);
+        int a = GetInputSlot(node, 2);
+        int b = GetInputSlot(node, 3);
+        if (dst == -1 || a == -1 || b == -1)
+        {
+            break;
+        }
+
+        int picked = GetPickedOption(node, 1);
+        OpCode op = OP_COUNT;
+        if (node->type == NODE_COMPARISON && picked >= EQUAL_TO && picked <= LESS_THAN)
+        {
+            op = OP_EQUAL_TO + picked;
+        }
+        else if (node->type == NODE_GATE && picked >= AND && picked <= NOR)
+        {
+            op = OP_AND + picked;
+        }
+        else if (node->type == NODE_ARITHMETIC && picked >= ADD && picked <= MODULO)
+        {
+            op = OP_ADD + picked;
+        }
+
+        if (op == OP_COUNT)
+        {
+            break;
+        }
+
+        Emit(compiler, op, dst, a, b, 0);
+        return;
+    }
+
+    case NODE_CLAMP:
+    {
+        int dst = GetOutputSlot(node, 1);
+        int num = GetInputSlot(node, 1);
+        int min = GetInputSlot(node, 2);
+        int max = GetInputSlot(node, 3);
+        if (dst == -1 || num == -1 || min == -1 || max == -1)
+        {
+            break;
+        }
+
+        Emit(compiler, OP_CLAMP, dst, num, min, max);
+        return;
+    }
+
+    case NODE_SIN:
+    case NODE_COS:
+    {
+        int dst = GetOutputSlot(node, 1);
+        int src = GetInputSlot(node, 1);
+        if (dst == -1 || src == -1)
+        {
+            break;
+        }
+
+        Emit(compiler, node->type == NODE_SIN ? OP_SIN : OP_COS, dst, src, 0, 0);
+        return;
+    }
+
+    default:
+        break;
+    }
+
+    Emit(compiler, OP_NODE, node->index, 0, 0, 0);
+}
+
+static int CompileChain(BytecodeCompiler *compiler, int nodeIndex)
+{
+    BytecodeProgram *program = compiler->program;
+    RuntimeGraphContext *graph = compiler->graph;
+
+    if (nodeIndex < 0)
+    {
+        return SHARED_RET_PC;
+    }
+
+    if (program->pcByNode[nodeIndex] != INVALID_PC)
+    {
+        return program->pcByNode[nodeIndex];
+    }
+
+    int entry = program->codeCount;
+
+    while (nodeIndex >= 0 && !compiler->outOfMemory)
+    {
+        if (program->pcByNode[nodeIndex] != INVALID_PC)
+        {
+            Emit(compiler, OP_JUMP, program->pcByNode[nodeIndex], 0, 0, 0);
+            return entry;
+        }
+
+        program->pcByNode[nodeIndex] = program->codeCount;
+        RuntimeNode *node = &graph->nodes[nodeIndex];
+
+        switch (node->type)
+        {
+        case NODE_BRANCH:
+        {
+            int condition = GetInputSlot(node, 1);
+            if (condition == -1)
+            {
+                Emit(compiler, OP_RET, 0, 0, 0, 0);
+                return entry;
+            }
+            int pc = Emit(compiler, OP_BRANCH, condition, SHARED_RET_PC, SHARED_RET_PC, 0);
+            EmitTarget(compiler, pc, 1, GetNextNodeIndex(graph, nodeIndex, 0));
+            EmitTarget(compiler, pc, 2, GetNextNodeIndex(graph, nodeIndex, 1));
+            return entry;
+        }
+
+        case NODE_LOOP:
+        {
+            int condition = GetInputSlot(node, 1);
+            if (condition == -1)
+            {
+                break;
+            }
+            int loopIndex = program->loopCount++;
+            Emit(compiler, OP_LOOP_ENTER, loopIndex, 0, 0, 0);
+            int testPc = Emit(compiler, OP_LOOP_TEST, condition, loopIndex, 0, 0);
+            int callPc = Emit(compiler, OP_CALL, SHARED_RET_PC, 0, 0, 0);
+            int breakPc = Emit(compiler, OP_LOOP_BREAK, 0, 0, 0, 0);
+            Emit(compiler, OP_JUMP, testPc, 0, 0, 0);
+            if (compiler->outOfMemory)
+            {
+                return entry;
+            }
+            program->code[testPc].c = program->codeCount;
+            program->code[breakPc].a = program->codeCount;
+            EmitTarget(compiler, callPc, 0, GetNextNodeIndex(graph, nodeIndex, 1));
+            break;
+        }
+
+        case NODE_FLIP_FLOP:
+        {
+            int pc = Emit(compiler, OP_FLIP_FLOP, nodeIndex, SHARED_RET_PC, SHARED_RET_PC, 0);
+            Emit(compiler, OP_FLIP_FLOP_TOGGLE, nodeIndex, 0, 0, 0);
+            Emit(compiler, OP_RET, 0, 0, 0, 0);
+            EmitTarget(compiler, pc, 1, GetNextNodeIndex(graph, nodeIndex, 0));
+            EmitTarget(compiler, pc, 2, GetNextNodeIndex(graph, nodeIndex, 1));
+            return entry;
+        }
+
+        case NODE_BREAK:
+            Emit(compiler, OP_BREAK, 0, 0, 0, 0);
+            Emit(compiler, OP_RET, 0, 0, 0, 0);
+            return entry;
+
+        case NODE_SEQUENCE:
+        {
+            int firstPc = Emit(compiler, OP_CALL, SHARED_RET_PC, 0, 0, 0);
+            int secondPc = Emit(compiler, OP_CALL, SHARED_RET_PC, 0, 0, 0);
+            int thirdPc = Emit(compiler, OP_JUMP, SHARED_RET_PC, 0, 0, 0);
+            EmitTarget(compiler, firstPc, 0, GetNextNodeIndex(graph, nodeIndex, 0));
+            EmitTarget(compiler, secondPc, 0, GetNextNodeIndex(graph, nodeIndex, 1));
+            EmitTarget(compiler, thirdPc, 0, GetNextNodeIndex(graph, nodeIndex, 2));
+            return entry;
+        }
+
+        default:
+            CompileNode(compiler, node);
+            break;
+        }
+
+        int next = GetNextNodeIndex(graph, nodeIndex, 0);
+        nodeIndex = next == nodeIndex ? -1 : next;
+    }
+
+    Emit(compiler, OP_RET, 0, 0, 0, 0);
+    return entry;
+}
+
+static void CompilePendingChains(BytecodeCompiler *compiler)
+{
+    while (compiler->pendingCount > 0 && !compiler->outOfMemory)
+    {
+        PendingTarget target = compiler->pending[--compiler->pendingCount];
+        int pc = CompileChain(compiler, target.nodeIndex);
+        *GetInstructionOperand(&compiler->program->code[target.pc], target.operand) = pc;
+    }
+}
+
+bool CompileRuntimeGraph(InterpreterContext *intp, RuntimeGraphContext *graph)
+{
+    BytecodeProgram *program = &intp->bytecode;
+    FreeBytecodeProgram(program);
+
+    program->nodeCount = graph->nodeCount;
+    program->entryByNode = malloc(sizeof(int) * (graph->nodeCount + 1));
+    program->pcByNode = malloc(sizeof(int) * (graph->nodeCount + 1));
+    program->loopSteps = calloc(graph->nodeCount + 1, sizeof(int));
+    program->callStack = malloc(sizeof(int) * BYTECODE_INITIAL_CALL_STACK_CAPACITY);
+    program->callStackCapacity = BYTECODE_INITIAL_CALL_STACK_CAPACITY;
+
+    BytecodeCompiler compiler = {.intp = intp, .graph = graph, .program = program};
+
+    if (!program->entryByNode || !program->pcByNode || !program->loopSteps || !program->callStack)
+    {
+        compiler.outOfMemory = true;
+    }
+    else
+    {
+        for (int i = 0; i < graph->nodeCount; i++)
+        {
+            program->entryByNode[i] = INVALID_PC;
+            program->pcByNode[i] = INVALID_PC;
+        }
+
+        Emit(&compiler, OP_RET, 0, 0, 0, 0);
+
+        for (int i = 0; i < graph->nodeCount && !compiler.outOfMemory; i++)
+        {
+            switch (graph->nodes[i].type)
+            {
+            case NODE_EVENT_START:
+            case NODE_EVENT_TICK:
+            case NODE_EVENT_ON_BUTTON:
+                program->entryByNode[i] = CompileChain(&compiler, GetNextNodeIndex(graph, i, 0));
+                CompilePendingChains(&compiler);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    free(compiler.pending);
+
+    if (compiler.outOfMemory)
+    {
+        FreeBytecodeProgram(program);
+        intp->buildFailed = true;
+        intp->buildErrorOccured = true;
+        AddToLogFromInterpreter(intp, "Out of memory: bytecode{I212}", LOG_LEVEL_ERROR);
+        return false;
+    }
+
+    program->isCompiled = true;
+    return true;
+}
+
+static bool GrowCallStack(BytecodeProgram *program)
+{
+    int newCapacity = program->callStackCapacity * 2;
+    int *newStack = realloc(program->callStack, sizeof(int) * newCapacity);
+    if (!newStack)
+    {
+        return false;
+    }
+    program->callStack = newStack;
+    program->callStackCapacity = newCapacity;
+    return true;
+}
+
+void RunBytecode(InterpreterContext *intp, RuntimeGraphContext *graph, int eventNodeIndex)
+{
+    BytecodeProgram *program = &intp->bytecode;
+
+    if (!program->isCompiled || eventNodeIndex < 0 || eventNodeIndex >= program->nodeCount || program->entryByNode[eventNodeIndex] == INVALID_PC)
+    {
+        return;
+    }
+
+    Value *values = intp->values;
+    const Instruction *code = program->code;
+    const Instruction *ip = &code[program->entryByNode[eventNodeIndex]];
+    int sp = 0;
+
+#ifdef BYTECODE_THREADED_DISPATCH
+    static void *dispatchTable[OP_COUNT] = {
+        [OP_RET] = &&L_OP_RET,
+        [OP_JUMP] = &&L_OP_JUMP,
+        [OP_CALL] = &&L_OP_CALL,
+        [OP_NODE] = &&L_OP_NODE,
+        [OP_BRANCH] = &&L_OP_BRANCH,
+        [OP_LOOP_ENTER] = &&L_OP_LOOP_ENTER,
+        [OP_LOOP_TEST] = &&L_OP_LOOP_TEST,
+        [OP_LOOP_BREAK] = &&L_OP_LOOP_BREAK,
+        [OP_FLIP_FLOP] = &&L_OP_FLIP_FLOP,
+        [OP_FLIP_FLOP_TOGGLE] = &&L_OP_FLIP_FLOP_TOGGLE,
+        [OP_BREAK] = &&L_OP_BREAK,
+        [OP_COPY_NUMBER] = &&L_OP_COPY_NUMBER,
+        [OP_COPY_STRING] = &&L_OP_COPY_STRING,
+        [OP_COPY_BOOL] = &&L_OP_COPY_BOOL,
+        [OP_COPY_COLOR] = &&L_OP_COPY_COLOR,
+        [OP_EQUAL_TO] = &&L_OP_EQUAL_TO,
+        [OP_GREATER_THAN] = &&L_OP_GREATER_THAN,
+        [OP_LESS_THAN] = &&L_OP_LESS_THAN,
+        [OP_AND] = &&L_OP_AND,
+        [OP_OR] = &&L_OP_OR,
+        [OP_NOT] = &&L_OP_NOT,
+        [OP_XOR] = &&L_OP_XOR,
+        [OP_NAND] = &&L_OP_NAND,
+        [OP_NOR] = &&L_OP_NOR,
+        [OP_ADD] = &&L_OP_ADD,
+        [OP_SUBTRACT] = &&L_OP_SUBTRACT,
+        [OP_MULTIPLY] = &&L_OP_MULTIPLY,
+        [OP_DIVIDE] = &&L_OP_DIVIDE,
+        [OP_MODULO] = &&L_OP_MODULO,
+        [OP_CLAMP] = &&L_OP_CLAMP,
+        [OP_SIN] = &&L_OP_SIN,
+        [OP_COS] = &&L_OP_COS};
+
+#define VM_DISPATCH() goto *dispatchTable[ip->op]
+#define VM_CASE(op) L_##op
+
+    VM_DISPATCH();
+#else
+#define VM_DISPATCH() goto dispatch
+#define VM_CASE(op) case op
+
+dispatch:
+    switch (ip->op)
+    {
+#endif
+
+    VM_CASE(OP_RET):
+        if (sp == 0)
+        {
+            return;
+        }
+        ip = &code[program->callStack[--sp]];
+        VM_DISPATCH();
+
+    VM_CASE(OP_JUMP):
+        ip = &code[ip->a];
+        VM_DISPATCH();
+
+    VM_CASE(OP_CALL):
+        if (sp >= program->callStackCapacity && !GrowCallStack(program))
+        {
+            AddToLogFromInterpreter(intp, "Out of memory: call stack{I213}", LOG_LEVEL_ERROR);
+            return;
+        }
+        program->callStack[sp++] = (int)(ip - code) + 1;
+        ip = &code[ip->a];
+        VM_DISPATCH();
+
+    VM_CASE(OP_NODE):
+        PROFILER_TIME_NODE(&intp->profiler, ip->a, ExecuteNode(intp, &graph->nodes[ip->a]));
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_BRANCH):
+        ip = &code[values[ip->a].boolean ? ip->b : ip->c];
+        VM_DISPATCH();
+
+    VM_CASE(OP_LOOP_ENTER):
+        program->loopSteps[ip->a] = MAX_ITERATIONS_BEFORE_ILP;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_LOOP_TEST):
+        if (!values[ip->a].boolean)
+        {
+            ip = &code[ip->c];
+            VM_DISPATCH();
+        }
+        if (program->loopSteps[ip->b] == 0)
+        {
+            if (intp->isInfiniteLoopProtectionOn)
+            {
+                AddToLogFromInterpreter(intp, "Possible infinite loop detected and exited! You can turn off infinite loop protection in settings{I210}", LOG_LEVEL_ERROR);
+                ip = &code[ip->c];
+                VM_DISPATCH();
+            }
+            AddToLogFromInterpreter(intp, "Possible infinite loop detected! Infinite loop protection is off!{I101}", LOG_LEVEL_WARNING);
+        }
+        else
+        {
+            program->loopSteps[ip->b]--;
+        }
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_LOOP_BREAK):
+        if (intp->shouldBreakFromLoop)
+        {
+            intp->shouldBreakFromLoop = false;
+            ip = &code[ip->a];
+            VM_DISPATCH();
+        }
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_FLIP_FLOP):
+        if (sp >= program->callStackCapacity && !GrowCallStack(program))
+        {
+            AddToLogFromInterpreter(intp, "Out of memory: call stack{I213}", LOG_LEVEL_ERROR);
+            return;
+        }
+        program->callStack[sp++] = (int)(ip - code) + 1;
+        ip = &code[graph->nodes[ip->a].flipFlopState ? ip->b : ip->c];
+        VM_DISPATCH();
+
+    VM_CASE(OP_FLIP_FLOP_TOGGLE):
+        graph->nodes[ip->a].flipFlopState = !graph->nodes[ip->a].flipFlopState;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_BREAK):
+        intp->shouldBreakFromLoop = true;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_COPY_NUMBER):
+        values[ip->a].number = values[ip->b].number;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_COPY_STRING):
+        values[ip->a].stringID = CopyString(&intp->strings, &intp->arena, values[ip->b].stringID);
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_COPY_BOOL):
+        values[ip->a].boolean = values[ip->b].boolean;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_COPY_COLOR):
+        values[ip->a].color = values[ip->b].color;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_EQUAL_TO):
+        values[ip->a].boolean = values[ip->b].number == values[ip->c].number;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_GREATER_THAN):
+        values[ip->a].boolean = values[ip->b].number > values[ip->c].number;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_LESS_THAN):
+        values[ip->a].boolean = values[ip->b].number < values[ip->c].number;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_AND):
+        values[ip->a].boolean = values[ip->b].boolean && values[ip->c].boolean;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_OR):
+        values[ip->a].boolean = values[ip->b].boolean || values[ip->c].boolean;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_NOT):
+        values[ip->a].boolean = !values[ip->b].boolean;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_XOR):
+        values[ip->a].boolean = values[ip->b].boolean != values[ip->c].boolean;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_NAND):
+        values[ip->a].boolean = !(values[ip->b].boolean && values[ip->c].boolean);
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_NOR):
+        values[ip->a].boolean = !(values[ip->b].boolean || values[ip->c].boolean);
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_ADD):
+        values[ip->a].number = values[ip->b].number + values[ip->c].number;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_SUBTRACT):
+        values[ip->a].number = values[ip->b].number - values[ip->c].number;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_MULTIPLY):
+        values[ip->a].number = values[ip->b].number * values[ip->c].number;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_DIVIDE):
+        values[ip->a].number = values[ip->b].number / values[ip->c].number;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_MODULO):
+        values[ip->a].number = (int)values[ip->b].number % (int)values[ip->c].number;
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_CLAMP):
+    {
+        float num = values[ip->b].number;
+        if (num < values[ip->c].number)
+        {
+            num = values[ip->c].number;
+        }
+        else if (num > values[ip->d].number)
+        {
+            num = values[ip->d].number;
+        }
+        values[ip->a].number = num;
+        ip++;
+        VM_DISPATCH();
+    }
+
+    VM_CASE(OP_SIN):
+        values[ip->a].number = sin(values[ip->b].number);
+        ip++;
+        VM_DISPATCH();
+
+    VM_CASE(OP_COS):
+        values[ip->a].number = cos(values[ip->b].number);
+        ip++;
+        VM_DISPATCH();
+
+#ifndef BYTECODE_THREADED_DISPATCH
+    default:
+        return;
+    }
+#endif
+
+#undef VM_DISPATCH
+#undef VM_CASE
+}
@@ -0,0 +1,82 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BYTECODE_THREADED_DISPATCH
+#endif
+
+#define BYTECODE_INITIAL_CODE_CAPACITY 256
+#define BYTECODE_INITIAL_CALL_STACK_CAPACITY 64
+
+// Operands are value slot indexes into intp->values unless noted otherwise
+typedef enum
+{
+    OP_RET,
+    OP_JUMP, // a: target
+    OP_CALL, // a: target
+    OP_NODE, // a: node index, executed by ExecuteNode
+    OP_BRANCH, // a: condition, b: true target, c: false target
+    OP_LOOP_ENTER, // a: loop index
+    OP_LOOP_TEST, // a: condition, b: loop index, c: exit target
+    OP_LOOP_BREAK, // a: exit target
+    OP_FLIP_FLOP, // a: node index, b: flip target, c: flop target
+    OP_FLIP_FLOP_TOGGLE, // a: node index
+    OP_BREAK,
+    OP_COPY_NUMBER, // a: destination, b: source
+    OP_COPY_STRING,
+    OP_COPY_BOOL,
+    OP_COPY_COLOR,
+    OP_EQUAL_TO, // a: destination, b: A, c: B
+    OP_GREATER_THAN,
+    OP_LESS_THAN,
+    OP_AND,
+    OP_OR,
+    OP_NOT,
+    OP_XOR,
+    OP_NAND,
+    OP_NOR,
+    OP_ADD,
+    OP_SUBTRACT,
+    OP_MULTIPLY,
+    OP_DIVIDE,
+    OP_MODULO,
+    OP_CLAMP, // a: destination, b: number, c: min, d: max
+    OP_SIN, // a: destination, b: radians
+    OP_COS,
+    OP_COUNT
+} OpCode;
+
+typedef struct
+{
+    OpCode op;
+    int a;
+    int b;
+    int c;
+    int d;
+} Instruction;
+
+typedef struct
+{
+    Instruction *code;
+    int codeCount;
+    int codeCapacity;
+
+    int *entryByNode;
+    int *pcByNode;
+    int nodeCount;
+
+    int *loopSteps;
+    int loopCount;
+
+    int *callStack;
+    int callStackCapacity;
+
+    bool isCompiled;
+} BytecodeProgram;
+
+void FreeBytecodeProgram(BytecodeProgram *program);
@@ -6,6 +6,7 @@
 #include <ctype.h>
 #include <math.h>
 #include "raymath.h"
+#include "rlgl.h"
 
 #define MENU_WIDTH 270
 #define MENU_ITEM_HEIGHT 40
@@ -77,6 +78,9 @@ CGEditorContext InitEditorContext()
     cgEd.createNodeMenuFirstFrame = true;
 
     cgEd.zoom = 1.0f;
+    cgEd.lod = NODE_LOD_FULL;
+
+    cgEd.camera = (Camera2D){.offset = {0, 0}, .target = {0, 0}, .rotation = 0.0f, .zoom = 1.0f};
 
     cgEd.nodeGlareTime = 0;
 
@@ -101,6 +105,15 @@ void FreeEditorContext(CGEditorContext *cgEd)
 
     UnloadFont(cgEd->font);
 
+    free(cgEd->visibleNodes);
+    cgEd->visibleNodes = NULL;
+    cgEd->visibleNodeCount = 0;
+    cgEd->visibleNodeCapacity = 0;
+
+    free(cgEd->wires);
+    cgEd->wires = NULL;
+    cgEd->wireCapacity = 0;
+
     if (cgEd->graph)
     {
         FreeGraphContext(cgEd->graph);
@@ -122,11 +135,8 @@ void AddToLogFromCGEditor(CGEditorContext *cgEd, char *message, int level)
 
 void DrawBackgroundGrid(CGEditorContext *cgEd, int gridSpacing, RenderTexture2D dot)
 {
-    static Vector2 offset;
-    if (cgEd->isDraggingScreen)
-    {
-        offset = Vector2Subtract(offset, Vector2Scale(GetMouseDelta(), 1.0f / (cgEd->zoom * cgEd->zoom)));
-    }
+    // Drawn in viewport texture coordinates, scrolled along with the camera
+    Vector2 offset = Vector2Scale(cgEd->camera.target, cgEd->camera.zoom / cgEd->zoom);
     gridSpacing = (gridSpacing / cgEd->zoom > 1) ? gridSpacing / cgEd->zoom : 1;
 
     float worldLeft = offset.x;
@@ -155,56 +165,106 @@ void DrawBackgroundGrid(CGEditorContext *cgEd, int gridSpacing, RenderTexture2D
     }
 }
 
-void DrawCurvedWire(Vector2 outputPos, Vector2 inputPos, float thickness, Color color, bool isLowSpecModeOn)
+void TessellateWire(WireGeometry *wire, Vector2 outputPos, Vector2 inputPos, bool isLowSpecModeOn)
 {
     const float inputOffset = 12.0f;
     const float outputOffset = 17.0f;
 
+    wire->outputPos = outputPos;
+    wire->inputPos = inputPos;
+    wire->isLowSpecModeOn = isLowSpecModeOn;
+    wire->isValid = true;
+
     float distance = fabsf(inputPos.x - outputPos.x);
     float controlOffset = distance * 0.5f;
 
-    DrawLineEx(outputPos, (Vector2){outputPos.x + outputOffset, outputPos.y}, thickness, color);
-    inputPos.x -= inputOffset;
-    outputPos.x += outputOffset;
-
-    Vector2 p0 = outputPos;
-    Vector2 p1 = {outputPos.x + controlOffset, outputPos.y};
-    Vector2 p2 = {inputPos.x - controlOffset, inputPos.y};
-    Vector2 p3 = inputPos;
+    Vector2 p0 = {outputPos.x + outputOffset, outputPos.y};
+    Vector2 p1 = {p0.x + controlOffset, p0.y};
+    Vector2 p3 = {inputPos.x - inputOffset, inputPos.y};
+    Vector2 p2 = {p3.x - controlOffset, p3.y};
 
     const int segments = isLowSpecModeOn ? 12 : Clamp((int)(distance / 8.0f), 12, 64);
 
-    Vector2 points[65];
-    points[0] = p0;
+    wire->points[0] = outputPos;
+    wire->points[1] = p0;
     for (int i = 1; i <= segments; i++)
     {
         float t = (float)i / segments;
         float u = 1.0f - t;
-        points[i] = (Vector2){
+        wire->points[i + 1] = (Vector2){
             u * u * u * p0.x + 3 * u * u * t * p1.x + 3 * u * t * t * p2.x + t * t * t * p3.x,
             u * u * u * p0.y + 3 * u * u * t * p1.y + 3 * u * t * t * p2.y + t * t * t * p3.y};
     }
+    wire->points[segments + 2] = inputPos;
+    wire->pointCount = segments + 3;
 
-    if (!isLowSpecModeOn)
+    Vector2 min = wire->points[0];
+    Vector2 max = wire->points[0];
+    for (int i = 1; i < wire->pointCount; i++)
     {
-        for (int glow = 3; glow > 0; glow--)
+        min = (Vector2){fminf(min.x, wire->points[i].x), fminf(min.y, wire->points[i].y)};
+        max = (Vector2){fmaxf(max.x, wire->points[i].x), fmaxf(max.y, wire->points[i].y)};
+    }
+    wire->bounds = (Rectangle){min.x, min.y, max.x - min.x, max.y - min.y};
+}
+
+// Same triangles as DrawLineEx, added to the batch started by the caller with rlBegin(RL_TRIANGLES)
+void BatchWireSegments(const Vector2 *points, int pointCount, float thickness, Color color)
+{
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    for (int i = 1; i < pointCount; i++)
+    {
+        Vector2 start = points[i - 1];
+        Vector2 end = points[i];
+        Vector2 delta = Vector2Subtract(end, start);
+        float length = Vector2Length(delta);
+        if (length <= 0)
         {
-            float glowThickness = thickness + glow * 1.2f;
-            Color glowColor = color;
-            glowColor.a = 100;
-            for (int i = 1; i <= segments; i++)
-            {
-                DrawLineEx(points[i - 1], points[i], glowThickness, glowColor);
-            }
+            continue;
         }
+
+        float scale = thickness / (2 * length);
+        Vector2 radius = {-scale * delta.y, scale * delta.x};
+        Vector2 a = Vector2Subtract(start, radius);
+        Vector2 b = Vector2Add(start, radius);
+        Vector2 c = Vector2Subtract(end, radius);
+        Vector2 d = Vector2Add(end, radius);
+
+        rlVertex2f(c.x, c.y);
+        rlVertex2f(a.x, a.y);
+        rlVertex2f(b.x, b.y);
+
+        rlVertex2f(d.x, d.y);
+        rlVertex2f(c.x, c.y);
+        rlVertex2f(b.x, b.y);
     }
+}
 
-    for (int i = 1; i <= segments; i++)
+void BatchWire(const WireGeometry *wire, float thickness, Color color)
+{
+    BatchWireSegments(wire->points, 2, thickness, color);
+
+    if (!wire->isLowSpecModeOn)
     {
-        DrawLineEx(points[i - 1], points[i], thickness, color);
+        Color glowColor = color;
+        glowColor.a = 100;
+        for (int glow = 3; glow > 0; glow--)
+        {
+            BatchWireSegments(wire->points + 1, wire->pointCount - 2, thickness + glow * 1.2f, glowColor);
+        }
     }
 
-    DrawLineEx(inputPos, (Vector2){inputPos.x + inputOffset, inputPos.y}, thickness, color);
+    BatchWireSegments(wire->points + 1, wire->pointCount - 1, thickness, color);
+}
+
+void DrawCurvedWire(Vector2 outputPos, Vector2 inputPos, float thickness, Color color, bool isLowSpecModeOn)
+{
+    WireGeometry wire;
+    TessellateWire(&wire, outputPos, inputPos, isLowSpecModeOn);
+
+    rlBegin(RL_TRIANGLES);
+    BatchWire(&wire, thickness, color);
+    rlEnd();
 }
 
 void HandleVarNameTextBox(CGEditorContext *cgEd, Rectangle bounds, char *text, int index, GraphContext *graph)
@@ -838,6 +898,42 @@ void HandleDropdownMenu(GraphContext *graph, int currPinIndex, int hoveredNodeIn
     }
 }
 
+void UpdateNodeLOD(CGEditorContext *cgEd)
+{
+    NodeLOD lod = cgEd->lod;
+
+    if (cgEd->zoom < NODE_LOD_FLAT_ZOOM)
+    {
+        lod = NODE_LOD_FLAT;
+    }
+    else if (cgEd->zoom < NODE_LOD_SIMPLE_ZOOM)
+    {
+        if (lod == NODE_LOD_FULL || cgEd->zoom > NODE_LOD_FLAT_ZOOM + NODE_LOD_HYSTERESIS)
+        {
+            lod = NODE_LOD_SIMPLE;
+        }
+    }
+    else if (cgEd->zoom > NODE_LOD_SIMPLE_ZOOM + NODE_LOD_HYSTERESIS)
+    {
+        lod = NODE_LOD_FULL;
+    }
+    else if (lod == NODE_LOD_FLAT)
+    {
+        lod = NODE_LOD_SIMPLE;
+    }
+
+    // Pins and fields are not drawn below full detail, so nothing can stay focused on them
+    if (lod != NODE_LOD_FULL && cgEd->lod == NODE_LOD_FULL)
+    {
+        cgEd->focusedDropdownPin = -1;
+        cgEd->focusedFieldPin = -1;
+        cgEd->editingNodeNameIndex = -1;
+        cgEd->lastClickedPin = INVALID_PIN;
+    }
+
+    cgEd->lod = lod;
+}
+
 void DrawNodes(CGEditorContext *cgEd, GraphContext *graph)
 {
     if (graph->nodeCount == 0)
@@ -845,43 +941,40 @@ void DrawNodes(CGEditorContext *cgEd, GraphContext *graph)
         return;
     }
 
-    for (int i = 0; i < graph->linkCount; i++)
-    {
-        Vector2 inputPinPosition;
-        Vector2 outputPinPosition;
-        bool isInputPosSet = false;
-        bool isOutputPosSet = false;
-        bool isInputFlow = false;
-        bool isOutputFlow = false;
-        PinType linkType;
-        for (int j = 0; j < graph->pinCount; j++)
-        {
-            if (graph->links[i].inputPinID == graph->pins[j].id)
-            {
-                inputPinPosition = graph->pins[j].position;
-                isInputPosSet = true;
-                isInputFlow = (graph->pins[j].type == PIN_FLOW);
+    UpdateNodeLOD(cgEd);
 
-                if (graph->pins[j].type != PIN_ANY_VALUE)
-                {
-                    linkType = graph->pins[j].type;
-                }
-            }
-            else if (graph->links[i].outputPinID == graph->pins[j].id)
-            {
-                outputPinPosition = graph->pins[j].position;
-                isOutputPosSet = true;
-                isOutputFlow = (graph->pins[j].type == PIN_FLOW);
+    if (!UpdateGraphDrawCache(graph))
+    {
+        AddToLogFromCGEditor(cgEd, "Out of memory{C222}", LOG_LEVEL_ERROR);
+        return;
+    }
 
-                if (graph->pins[j].type != PIN_ANY_VALUE)
-                {
-                    linkType = graph->pins[j].type;
-                }
-            }
+    if (cgEd->wireCapacity < graph->linkCount)
+    {
+        WireGeometry *newWires = realloc(cgEd->wires, sizeof(WireGeometry) * graph->linkCount);
+        if (!newWires)
+        {
+            AddToLogFromCGEditor(cgEd, "Out of memory{C222}", LOG_LEVEL_ERROR);
+            return;
         }
-        bool isFlowLink = isInputFlow && isOutputFlow;
-        if (isInputPosSet && isOutputPosSet)
+        memset(newWires + cgEd->wireCapacity, 0, sizeof(WireGeometry) * (graph->linkCount - cgEd->wireCapacity));
+        cgEd->wires = newWires;
+        cgEd->wireCapacity = graph->linkCount;
+    }
+
+    // Every visible wire goes into one batch
+    rlBegin(RL_TRIANGLES);
+    for (int i = 0; i < graph->linkCount; i++)
+    {
+        int inputPinIndex = graph->linkEndpoints[i].inputPinIndex;
+        int outputPinIndex = graph->linkEndpoints[i].outputPinIndex;
+        if (inputPinIndex != -1 && outputPinIndex != -1)
         {
+            Pin *inputPin = &graph->pins[inputPinIndex];
+            Pin *outputPin = &graph->pins[outputPinIndex];
+            bool isFlowLink = inputPin->type == PIN_FLOW && outputPin->type == PIN_FLOW;
+            PinType linkType = outputPin->type != PIN_ANY_VALUE ? outputPin->type : inputPin->type;
+
             Color wireColor;
             switch (linkType)
             {
@@ -906,13 +999,40 @@ void DrawNodes(CGEditorContext *cgEd, GraphContext *graph)
             default:
                 wireColor = COLOR_CGED_WIRE_UNKNOWN;
             }
-            DrawCurvedWire(outputPinPosition, inputPinPosition, 2.0f + 1.0f / cgEd->zoom + isFlowLink, wireColor, cgEd->isLowSpecModeOn);
+
+            float thickness = 2.0f + 1.0f / cgEd->zoom + isFlowLink;
+
+            if (cgEd->lod == NODE_LOD_FLAT)
+            {
+                Vector2 points[2] = {outputPin->position, inputPin->position};
+                Rectangle bounds = {fminf(points[0].x, points[1].x) - thickness, fminf(points[0].y, points[1].y) - thickness, fabsf(points[1].x - points[0].x) + 2 * thickness, fabsf(points[1].y - points[0].y) + 2 * thickness};
+                if (CheckCollisionRecs(cgEd->viewportBoundary, bounds))
+                {
+                    BatchWireSegments(points, 2, thickness, wireColor);
+                }
+                continue;
+            }
+
+            bool isLowSpecWire = cgEd->isLowSpecModeOn || cgEd->lod != NODE_LOD_FULL;
+            WireGeometry *wire = &cgEd->wires[i];
+            if (!wire->isValid || wire->isLowSpecModeOn != isLowSpecWire || wire->outputPos.x != outputPin->position.x || wire->outputPos.y != outputPin->position.y || wire->inputPos.x != inputPin->position.x || wire->inputPos.y != inputPin->position.y)
+            {
+                TessellateWire(wire, outputPin->position, inputPin->position, isLowSpecWire);
+            }
+
+            float margin = thickness / 2 + 3 * 1.2f;
+            Rectangle bounds = {wire->bounds.x - margin, wire->bounds.y - margin, wire->bounds.width + 2 * margin, wire->bounds.height + 2 * margin};
+            if (CheckCollisionRecs(cgEd->viewportBoundary, bounds))
+            {
+                BatchWire(wire, thickness, wireColor);
+            }
         }
         else
         {
             AddToLogFromCGEditor(cgEd, "Error drawing connection{C110}", LOG_LEVEL_WARNING);
         }
     }
+    rlEnd();
 
     static Rectangle textBoxRect = {0};
 
@@ -920,8 +1040,30 @@ void DrawNodes(CGEditorContext *cgEd, GraphContext *graph)
 
     cgEd->hoveredNodeIndex = -1;
 
-    for (int i = 0; i < graph->nodeCount; i++)
+    int visibleNodeCount = QueryNodesInRect(graph, cgEd->viewportBoundary);
+    if (visibleNodeCount == -1)
+    {
+        AddToLogFromCGEditor(cgEd, "Out of memory{C222}", LOG_LEVEL_ERROR);
+        return;
+    }
+    if (cgEd->visibleNodeCapacity < visibleNodeCount)
     {
+        int *newVisibleNodes = realloc(cgEd->visibleNodes, sizeof(int) * graph->nodeCount);
+        if (!newVisibleNodes)
+        {
+            AddToLogFromCGEditor(cgEd, "Out of memory{C222}", LOG_LEVEL_ERROR);
+            return;
+        }
+        cgEd->visibleNodes = newVisibleNodes;
+        cgEd->visibleNodeCapacity = graph->nodeCount;
+    }
+    // Copied since the name text box and later queries reuse the results
+    memcpy(cgEd->visibleNodes, graph->nodeGrid.results, sizeof(int) * visibleNodeCount);
+    cgEd->visibleNodeCount = visibleNodeCount;
+
+    for (int v = 0; v < cgEd->visibleNodeCount; v++)
+    {
+        int i = cgEd->visibleNodes[v];
         float x = graph->nodes[i].position.x;
         float y = graph->nodes[i].position.y;
         float width = getNodeInfoByType(graph->nodes[i].type, INFO_NODE_WIDTH);
@@ -930,11 +1072,6 @@ void DrawNodes(CGEditorContext *cgEd, GraphContext *graph)
         float segments = 8;
         int glareOffset = 0;
 
-        if (!CheckCollisionRecs(cgEd->viewportBoundary, (Rectangle){x, y, width, height}))
-        {
-            continue;
-        }
-
         if (!isAnyMenuOpen && CheckCollisionPointRec(cgEd->mousePos, (Rectangle){graph->nodes[i].position.x, graph->nodes[i].position.y, getNodeInfoByType(graph->nodes[i].type, INFO_NODE_WIDTH), getNodeInfoByType(graph->nodes[i].type, INFO_NODE_HEIGHT)}))
         {
             if (!cgEd->isDraggingSelectedNodes)
@@ -948,6 +1085,12 @@ void DrawNodes(CGEditorContext *cgEd, GraphContext *graph)
 
         Color nodeColor = getNodeColorByType(graph->nodes[i].type);
 
+        if (cgEd->lod == NODE_LOD_FLAT)
+        {
+            DrawRectangleRec((Rectangle){x, y, width, height}, nodeColor);
+            continue;
+        }
+
         Color nodeLeftGradientColor = {
             (unsigned char)Clamp((int)nodeColor.r + 40 + glareOffset, 0, 255),
             (unsigned char)Clamp((int)nodeColor.g + 40 + glareOffset, 0, 255),
@@ -970,7 +1113,7 @@ void DrawNodes(CGEditorContext *cgEd, GraphContext *graph)
 
         DrawRectangleRounded((Rectangle){x, y, width, height}, roundness, segments, nodeBackgroundColor);
 
-        if (cgEd->isLowSpecModeOn)
+        if (cgEd->isLowSpecModeOn || cgEd->lod == NODE_LOD_SIMPLE)
         {
             DrawCircleSector((Vector2){x + fullRadius - 2, y + fullRadius - 2}, fullRadius, 180, 270, segments, nodeColor);
 
@@ -991,7 +1134,12 @@ void DrawNodes(CGEditorContext *cgEd, GraphContext *graph)
             DrawRectangleGradientH(x - 2, y + fullRadius - 2, width + 4, 38 - fullRadius, nodeLeftGradientColor, nodeRightGradientColor);
         }
 
-        DrawRectangleRoundedLinesEx((Rectangle){x - 1, y - 1, width + 2, height + 2}, roundness, segments, 2.0f + 1.0f / round(cgEd->zoom), COLOR_CGED_NODE_BORDER);
+        DrawRectangleRoundedLinesEx((Rectangle){x - 1, y - 1, width + 2, height + 2}, roundness, segments, 2.0f + 1.0f / fmaxf(roundf(cgEd->zoom), 1.0f), COLOR_CGED_NODE_BORDER);
+
+        if (cgEd->lod == NODE_LOD_SIMPLE)
+        {
+            continue;
+        }
 
         DrawTextEx(cgEd->font, NodeTypeToString(graph->nodes[i].type), (Vector2){x + 8, y + 6}, 28, 1, WHITE);
 
@@ -1028,147 +1176,124 @@ void DrawNodes(CGEditorContext *cgEd, GraphContext *graph)
 
     cgEd->hoveredPinIndex = -1;
 
-    for (int i = 0; i < graph->pinCount; i++)
+    // Pins of nodes outside the viewport are skipped, their positions only change when the node moves.
+    // Below full detail no pins are drawn at all
+    int pinNodeCount = cgEd->lod == NODE_LOD_FULL ? cgEd->visibleNodeCount : 0;
+    for (int v = 0; v < pinNodeCount; v++)
     {
-        int currNodeIndex = -1;
+        int currNodeIndex = cgEd->visibleNodes[v];
+        Node *currNode = &graph->nodes[currNodeIndex];
 
-        for (int j = 0; j < graph->nodeCount; j++)
+        for (int p = 0; p < currNode->inputCount + currNode->outputCount; p++)
         {
-            if (graph->nodes[j].id == graph->pins[i].nodeID)
+            int i = FindPinIndexByID(graph, p < currNode->inputCount ? currNode->inputPins[p] : currNode->outputPins[p - currNode->inputCount]);
+            if (i == -1)
             {
-                currNodeIndex = j;
-                break;
+                TraceLog(LOG_WARNING, "Node %d has a missing pin", currNode->id);
+                continue;
             }
-        }
-
-        if (currNodeIndex == -1)
-        {
-            TraceLog(LOG_WARNING, "Pin %d has no matching node (ID %d)", i, graph->pins[i].nodeID);
-            continue;
-        }
 
-        Vector2 nodePos = graph->nodes[currNodeIndex].position;
-        int xOffset = graph->pins[i].isInput ? 5 : (getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH) - 20);
-        int yOffset = 52 + graph->pins[i].posInNode * 30;
+            Vector2 nodePos = currNode->position;
+            int xOffset = graph->pins[i].isInput ? 5 : (getNodeInfoByType(currNode->type, INFO_NODE_WIDTH) - 20);
+            int yOffset = 52 + graph->pins[i].posInNode * 30;
 
-        graph->pins[i].position = (Vector2){nodePos.x + xOffset + 5, nodePos.y + yOffset};
-
-        if (graph->pins[i].type == PIN_NONE)
-        {
-            continue;
-        }
-        else if (graph->pins[i].type == PIN_FLOW)
-        {
-            DrawTriangle((Vector2){nodePos.x + xOffset, nodePos.y + yOffset - 8}, (Vector2){nodePos.x + xOffset, nodePos.y + yOffset + 8}, (Vector2){nodePos.x + xOffset + 15, nodePos.y + yOffset}, WHITE);
-            if (!isAnyMenuOpen && CheckCollisionPointRec(cgEd->mousePos, (Rectangle){nodePos.x + xOffset - 5, nodePos.y + yOffset - 15, 25, 31}))
+            if (graph->pins[i].type == PIN_NONE)
+            {
+                continue;
+            }
+            else if (graph->pins[i].type == PIN_FLOW)
             {
-                if (graph->pins[i].isInput)
+                DrawTriangle((Vector2){nodePos.x + xOffset, nodePos.y + yOffset - 8}, (Vector2){nodePos.x + xOffset, nodePos.y + yOffset + 8}, (Vector2){nodePos.x + xOffset + 15, nodePos.y + yOffset}, WHITE);
+                if (!isAnyMenuOpen && CheckCollisionPointRec(cgEd->mousePos, (Rectangle){nodePos.x + xOffset - 5, nodePos.y + yOffset - 15, 25, 31}))
                 {
-                    DrawTextEx(cgEd->font, getNodeInputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], (Vector2){(2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 - MeasureTextEx(cgEd->font, getNodeInputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2, nodePos.y + yOffset - 8}, 18, 0, WHITE);
-                    DrawLine(graph->pins[i].position.x, graph->pins[i].position.y, (2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 - MeasureTextEx(cgEd->font, getNodeInputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2 - 5, graph->pins[i].position.y, WHITE);
+                    if (graph->pins[i].isInput)
+                    {
+                        DrawTextEx(cgEd->font, getNodeInputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], (Vector2){(2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 - MeasureTextEx(cgEd->font, getNodeInputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2, nodePos.y + yOffset - 8}, 18, 0, WHITE);
+                        DrawLine(graph->pins[i].position.x, graph->pins[i].position.y, (2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 - MeasureTextEx(cgEd->font, getNodeInputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2 - 5, graph->pins[i].position.y, WHITE);
+                    }
+                    else
+                    {
+                        DrawTextEx(cgEd->font, getNodeOutputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], (Vector2){(2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 - MeasureTextEx(cgEd->font, getNodeOutputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2 - 5, nodePos.y + yOffset - 8}, 18, 0, WHITE);
+                        DrawLine(graph->pins[i].position.x, graph->pins[i].position.y, (2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 + MeasureTextEx(cgEd->font, getNodeOutputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2, graph->pins[i].position.y, WHITE);
+                    }
+                    DrawTriangle((Vector2){nodePos.x + xOffset - 2, nodePos.y + yOffset - 10}, (Vector2){nodePos.x + xOffset - 2, nodePos.y + yOffset + 10}, (Vector2){nodePos.x + xOffset + 17, nodePos.y + yOffset}, WHITE);
+                    cgEd->hoveredPinIndex = i;
                 }
-                else
+            }
+            else if (graph->pins[i].type == PIN_DROPDOWN_COMPARISON_OPERATOR || graph->pins[i].type == PIN_DROPDOWN_GATE || graph->pins[i].type == PIN_DROPDOWN_ARITHMETIC || graph->pins[i].type == PIN_DROPDOWN_KEY_ACTION || graph->pins[i].type == PIN_DROPDOWN_LAYER || graph->pins[i].type == PIN_VARIABLE || graph->pins[i].type == PIN_SPRITE_VARIABLE)
+            {
+                if (cgEd->focusedDropdownPin != i)
                 {
-                    DrawTextEx(cgEd->font, getNodeOutputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], (Vector2){(2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 - MeasureTextEx(cgEd->font, getNodeOutputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2 - 5, nodePos.y + yOffset - 8}, 18, 0, WHITE);
-                    DrawLine(graph->pins[i].position.x, graph->pins[i].position.y, (2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 + MeasureTextEx(cgEd->font, getNodeOutputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2, graph->pins[i].position.y, WHITE);
+                    HandleDropdownMenu(graph, i, cgEd->hoveredNodeIndex, currNodeIndex, cgEd);
                 }
-                DrawTriangle((Vector2){nodePos.x + xOffset - 2, nodePos.y + yOffset - 10}, (Vector2){nodePos.x + xOffset - 2, nodePos.y + yOffset + 10}, (Vector2){nodePos.x + xOffset + 17, nodePos.y + yOffset}, WHITE);
-                cgEd->hoveredPinIndex = i;
             }
-        }
-        else if (graph->pins[i].type == PIN_DROPDOWN_COMPARISON_OPERATOR || graph->pins[i].type == PIN_DROPDOWN_GATE || graph->pins[i].type == PIN_DROPDOWN_ARITHMETIC || graph->pins[i].type == PIN_DROPDOWN_KEY_ACTION || graph->pins[i].type == PIN_DROPDOWN_LAYER || graph->pins[i].type == PIN_VARIABLE || graph->pins[i].type == PIN_SPRITE_VARIABLE)
-        {
-            if (cgEd->focusedDropdownPin != i)
+            else if (graph->pins[i].type == PIN_FIELD_NUM || graph->pins[i].type == PIN_FIELD_STRING || graph->pins[i].type == PIN_FIELD_BOOL || graph->pins[i].type == PIN_FIELD_COLOR)
             {
-                HandleDropdownMenu(graph, i, cgEd->hoveredNodeIndex, currNodeIndex, cgEd);
+                HandleLiteralNodeField(cgEd, graph, i);
             }
-        }
-        else if (graph->pins[i].type == PIN_FIELD_NUM || graph->pins[i].type == PIN_FIELD_STRING || graph->pins[i].type == PIN_FIELD_BOOL || graph->pins[i].type == PIN_FIELD_COLOR)
-        {
-            HandleLiteralNodeField(cgEd, graph, i);
-        }
-        else if (graph->pins[i].type == PIN_FIELD_KEY)
-        {
-            HandleKeyNodeField(cgEd, graph, i);
-        }
-        else if (graph->pins[i].type == PIN_EDIT_HITBOX)
-        {
-            DrawRectangleRounded((Rectangle){graph->pins[i].position.x - 6, graph->pins[i].position.y - 10, 96, 24}, 0.4f, 4, DARKPURPLE);
-            if (CheckCollisionPointRec(cgEd->mousePos, (Rectangle){graph->pins[i].position.x - 6, graph->pins[i].position.y - 10, 96, 24}))
+            else if (graph->pins[i].type == PIN_FIELD_KEY)
             {
-                DrawRectangleRounded((Rectangle){graph->pins[i].position.x - 6, graph->pins[i].position.y - 10, 96, 24}, 0.4f, 4, COLOR_CGED_EDIT_HITBOX_BTN_HOVER);
-                if (cgEd->isLMBPressed)
+                HandleKeyNodeField(cgEd, graph, i);
+            }
+            else if (graph->pins[i].type == PIN_EDIT_HITBOX)
+            {
+                DrawRectangleRounded((Rectangle){graph->pins[i].position.x - 6, graph->pins[i].position.y - 10, 96, 24}, 0.4f, 4, DARKPURPLE);
+                if (CheckCollisionPointRec(cgEd->mousePos, (Rectangle){graph->pins[i].position.x - 6, graph->pins[i].position.y - 10, 96, 24}))
                 {
-                    for (int b = 0; b < graph->nodeCount; b++)
+                    DrawRectangleRounded((Rectangle){graph->pins[i].position.x - 6, graph->pins[i].position.y - 10, 96, 24}, 0.4f, 4, COLOR_CGED_EDIT_HITBOX_BTN_HOVER);
+                    if (cgEd->isLMBPressed)
                     {
-                        if (graph->nodes[b].id == graph->pins[i].nodeID)
+                        // The texture is the string literal connected to the sprite input of this node
+                        for (int k = 0; k < graph->linkCount && currNode->inputCount > 1; k++)
                         {
-                            for (int c = 0; c < graph->pinCount; c++)
+                            if (graph->links[k].inputPinID == currNode->inputPins[1])
                             {
-                                if (graph->nodes[b].inputPins[1] == graph->pins[c].id)
+                                int outputPinIndex = graph->linkEndpoints[k].outputPinIndex;
+                                int d = outputPinIndex != -1 ? graph->nodeIndexByPin[outputPinIndex] : -1;
+                                if (d != -1 && graph->nodes[d].type == NODE_LITERAL_STRING && graph->nodes[d].outputPins[0] == graph->links[k].outputPinID)
                                 {
-                                    for (int k = 0; k < graph->linkCount; k++)
+                                    int e = FindPinIndexByID(graph, graph->nodes[d].inputPins[0]);
+                                    if (e != -1)
                                     {
-                                        if (graph->links[k].inputPinID == graph->pins[c].id)
-                                        {
-                                            for (int d = 0; d < graph->nodeCount; d++)
-                                            {
-                                                if (graph->nodes[d].outputPins[0] == graph->links[k].outputPinID)
-                                                {
-                                                    if (graph->nodes[d].type == NODE_LITERAL_STRING)
-                                                    {
-                                                        for (int e = 0; e < graph->pinCount; e++)
-                                                        {
-                                                            if (graph->pins[e].id == graph->nodes[d].inputPins[0])
-                                                            {
-                                                                cgEd->shouldOpenHitboxEditor = true;
-                                                                strmac(cgEd->hitboxEditorFileName, MAX_FILE_NAME, "%s", graph->pins[e].textFieldValue);
-                                                                cgEd->hitboxEditingPinID = graph->pins[i].id;
-                                                                return;
-                                                            }
-                                                        }
-                                                    }
-                                                    break;
-                                                }
-                                            }
-                                            break;
-                                        }
+                                        cgEd->shouldOpenHitboxEditor = true;
+                                        strmac(cgEd->hitboxEditorFileName, MAX_FILE_NAME, "%s", graph->pins[e].textFieldValue);
+                                        cgEd->hitboxEditingPinID = graph->pins[i].id;
+                                        return;
                                     }
-                                    break;
                                 }
+                                break;
                             }
-                            break;
                         }
+                        AddToLogFromCGEditor(cgEd, "Couldn't find sprite texture{H100}", LOG_LEVEL_WARNING);
                     }
-                    AddToLogFromCGEditor(cgEd, "Couldn't find sprite texture{H100}", LOG_LEVEL_WARNING);
                 }
+                DrawTextEx(cgEd->font, "Edit Hitbox", (Vector2){graph->pins[i].position.x - 2, graph->pins[i].position.y - 6}, 18, 0.2f, WHITE);
             }
-            DrawTextEx(cgEd->font, "Edit Hitbox", (Vector2){graph->pins[i].position.x - 2, graph->pins[i].position.y - 6}, 18, 0.2f, WHITE);
-        }
-        else
-        {
-            DrawCircle(nodePos.x + xOffset + 5, nodePos.y + yOffset, 5, WHITE);
-            if (!isAnyMenuOpen && CheckCollisionPointCircle(cgEd->mousePos, (Vector2){nodePos.x + xOffset + 5, nodePos.y + yOffset}, 12))
+            else
             {
-                if (graph->pins[i].isInput)
-                {
-                    DrawTextEx(cgEd->font, getNodeInputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], (Vector2){(2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 - MeasureTextEx(cgEd->font, getNodeInputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2, nodePos.y + yOffset - 8}, 18, 0, WHITE);
-                    DrawLine(graph->pins[i].position.x, graph->pins[i].position.y, (2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 - MeasureTextEx(cgEd->font, getNodeInputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2 - 5, graph->pins[i].position.y, WHITE);
-                }
-                else if (graph->nodes[currNodeIndex].type == NODE_COMPARISON || graph->nodes[currNodeIndex].type == NODE_GATE || graph->nodes[currNodeIndex].type == NODE_LITERAL_NUMBER || graph->nodes[currNodeIndex].type == NODE_LITERAL_STRING || graph->nodes[currNodeIndex].type == NODE_LITERAL_BOOL || graph->nodes[currNodeIndex].type == NODE_LITERAL_COLOR || graph->nodes[currNodeIndex].type == NODE_GET_SPRITE_POSITION)
-                {
-                    const char *label = getNodeOutputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode];
-                    Vector2 textSize = MeasureTextEx(cgEd->font, label, 18, 0);
-                    DrawTextEx(cgEd->font, label, (Vector2){graph->pins[i].position.x - textSize.x - 12, graph->pins[i].position.y - textSize.y / 2}, 18, 0, WHITE);
-                    DrawLine(graph->pins[i].position.x, graph->pins[i].position.y, graph->pins[i].position.x - 10, graph->pins[i].position.y, WHITE);
-                }
-                else
+                DrawCircle(nodePos.x + xOffset + 5, nodePos.y + yOffset, 5, WHITE);
+                if (!isAnyMenuOpen && CheckCollisionPointCircle(cgEd->mousePos, (Vector2){nodePos.x + xOffset + 5, nodePos.y + yOffset}, 12))
                 {
-                    DrawTextEx(cgEd->font, getNodeOutputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], (Vector2){(2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 - MeasureTextEx(cgEd->font, getNodeOutputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2 - 5, nodePos.y + yOffset - 8}, 18, 0, WHITE);
-                    DrawLine(graph->pins[i].position.x, graph->pins[i].position.y, (2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 + MeasureTextEx(cgEd->font, getNodeOutputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2, graph->pins[i].position.y, WHITE);
+                    if (graph->pins[i].isInput)
+                    {
+                        DrawTextEx(cgEd->font, getNodeInputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], (Vector2){(2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 - MeasureTextEx(cgEd->font, getNodeInputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2, nodePos.y + yOffset - 8}, 18, 0, WHITE);
+                        DrawLine(graph->pins[i].position.x, graph->pins[i].position.y, (2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 - MeasureTextEx(cgEd->font, getNodeInputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2 - 5, graph->pins[i].position.y, WHITE);
+                    }
+                    else if (graph->nodes[currNodeIndex].type == NODE_COMPARISON || graph->nodes[currNodeIndex].type == NODE_GATE || graph->nodes[currNodeIndex].type == NODE_LITERAL_NUMBER || graph->nodes[currNodeIndex].type == NODE_LITERAL_STRING || graph->nodes[currNodeIndex].type == NODE_LITERAL_BOOL || graph->nodes[currNodeIndex].type == NODE_LITERAL_COLOR || graph->nodes[currNodeIndex].type == NODE_GET_SPRITE_POSITION)
+                    {
+                        const char *label = getNodeOutputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode];
+                        Vector2 textSize = MeasureTextEx(cgEd->font, label, 18, 0);
+                        DrawTextEx(cgEd->font, label, (Vector2){graph->pins[i].position.x - textSize.x - 12, graph->pins[i].position.y - textSize.y / 2}, 18, 0, WHITE);
+                        DrawLine(graph->pins[i].position.x, graph->pins[i].position.y, graph->pins[i].position.x - 10, graph->pins[i].position.y, WHITE);
+                    }
+                    else
+                    {
+                        DrawTextEx(cgEd->font, getNodeOutputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], (Vector2){(2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 - MeasureTextEx(cgEd->font, getNodeOutputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2 - 5, nodePos.y + yOffset - 8}, 18, 0, WHITE);
+                        DrawLine(graph->pins[i].position.x, graph->pins[i].position.y, (2 * nodePos.x + getNodeInfoByType(graph->nodes[currNodeIndex].type, INFO_NODE_WIDTH)) / 2 + MeasureTextEx(cgEd->font, getNodeOutputNamesByType(graph->nodes[currNodeIndex].type)[graph->pins[i].posInNode], 18, 0).x / 2, graph->pins[i].position.y, WHITE);
+                    }
+                    DrawCircle(nodePos.x + xOffset + 5, nodePos.y + yOffset, 7, WHITE);
+                    cgEd->hoveredPinIndex = i;
                 }
-                DrawCircle(nodePos.x + xOffset + 5, nodePos.y + yOffset, 7, WHITE);
-                cgEd->hoveredPinIndex = i;
             }
         }
     }
@@ -1185,13 +1310,10 @@ void DrawNodes(CGEditorContext *cgEd, GraphContext *graph)
 
     if (cgEd->focusedDropdownPin != -1)
     {
-        for (int j = 0; j < graph->nodeCount; j++)
+        int focusedNodeIndex = graph->nodeIndexByPin[cgEd->focusedDropdownPin];
+        if (focusedNodeIndex != -1)
         {
-            if (graph->nodes[j].id == graph->pins[cgEd->focusedDropdownPin].nodeID)
-            {
-                HandleDropdownMenu(graph, cgEd->focusedDropdownPin, cgEd->hoveredNodeIndex, j, cgEd);
-                break;
-            }
+            HandleDropdownMenu(graph, cgEd->focusedDropdownPin, cgEd->hoveredNodeIndex, focusedNodeIndex, cgEd);
         }
     }
 
@@ -1265,15 +1387,8 @@ void DrawNodes(CGEditorContext *cgEd, GraphContext *graph)
 
 bool CheckNodeCollisions(CGEditorContext *cgEd, GraphContext *graph)
 {
-    for (int i = 0; i < graph->nodeCount; i++)
-    {
-        if (CheckCollisionPointRec(cgEd->mousePos, (Rectangle){graph->nodes[i].position.x, graph->nodes[i].position.y, getNodeInfoByType(graph->nodes[i].type, INFO_NODE_WIDTH), getNodeInfoByType(graph->nodes[i].type, INFO_NODE_HEIGHT)}))
-        {
-            return true;
-        }
-    }
-
-    return false;
+    // Out of memory counts as a hit, so the editor keeps redrawing
+    return QueryNodesAtPoint(graph, cgEd->mousePos) != 0;
 }
 
 const char *Search(const char *haystack, const char *needle)
@@ -1385,7 +1500,7 @@ const char *DrawNodeMenu(CGEditorContext *cgEd, RenderTexture2D view)
         }
 
         Rectangle menuRect = {cgEd->menuPosition.x, cgEd->menuPosition.y + searchBarHeight + 10, MENU_WIDTH, menuHeight - searchBarHeight - 10};
-        cgEd->submenuPosition.x = (cgEd->menuPosition.x + MENU_WIDTH + SUBMENU_WIDTH > cgEd->screenWidth)
+        cgEd->submenuPosition.x = (cgEd->menuPosition.x + MENU_WIDTH + SUBMENU_WIDTH > cgEd->camera.target.x + cgEd->screenWidth / cgEd->camera.zoom)
                                       ? (cgEd->menuPosition.x - SUBMENU_WIDTH)
                                       : (cgEd->menuPosition.x + MENU_WIDTH - 15);
         cgEd->submenuPosition.y = cgEd->menuPosition.y + searchBarHeight + 7;
@@ -1439,7 +1554,7 @@ const char *DrawNodeMenu(CGEditorContext *cgEd, RenderTexture2D view)
             if (CheckCollisionPointRec(cgEd->mousePos, itemRect))
             {
                 cgEd->hoveredItem = listIndex;
-                cgEd->submenuPosition.x = (cgEd->menuPosition.x + MENU_WIDTH + SUBMENU_WIDTH > cgEd->screenWidth)
+                cgEd->submenuPosition.x = (cgEd->menuPosition.x + MENU_WIDTH + SUBMENU_WIDTH > cgEd->camera.target.x + cgEd->screenWidth / cgEd->camera.zoom)
                                               ? (cgEd->menuPosition.x - SUBMENU_WIDTH)
                                               : (cgEd->menuPosition.x + MENU_WIDTH - 15);
                 cgEd->submenuPosition.y = itemRect.y - 3;
@@ -1514,39 +1629,38 @@ void HandleDragging(CGEditorContext *cgEd, GraphContext *graph)
 {
     if (cgEd->isLMBPressed && !cgEd->isDraggingSelectedNodes && cgEd->focusedFieldPin == -1 && cgEd->focusedDropdownPin == -1)
     {
-        for (int i = 0; i < graph->nodeCount; i++)
+        int hitCount = QueryNodesAtPoint(graph, cgEd->mousePos);
+        if (hitCount > 0)
         {
-            if (CheckCollisionPointRec(cgEd->mousePos, (Rectangle){graph->nodes[i].position.x, graph->nodes[i].position.y, getNodeInfoByType(graph->nodes[i].type, INFO_NODE_WIDTH), getNodeInfoByType(graph->nodes[i].type, INFO_NODE_HEIGHT)}))
+            int i = graph->nodeGrid.results[0];
+            cgEd->isDraggingSelectedNodes = true;
+            bool nodeAlreadySelected = false;
+            for (int j = 0; j < cgEd->selectedNodesCount; j++)
             {
-                cgEd->isDraggingSelectedNodes = true;
-                bool nodeAlreadySelected = false;
-                for (int j = 0; j < cgEd->selectedNodesCount; j++)
+                if (cgEd->selectedNodes[j] == i)
                 {
-                    if (cgEd->selectedNodes[j] == i)
+                    if (IsKeyDown(KEY_LEFT_CONTROL))
                     {
-                        if (IsKeyDown(KEY_LEFT_CONTROL))
+                        for (int k = j; k < cgEd->selectedNodesCount - 1; k++)
                         {
-                            for (int k = j; k < cgEd->selectedNodesCount - 1; k++)
-                            {
-                                cgEd->selectedNodes[k] = cgEd->selectedNodes[k + 1];
-                            }
-                            cgEd->selectedNodesCount--;
+                            cgEd->selectedNodes[k] = cgEd->selectedNodes[k + 1];
                         }
-                        nodeAlreadySelected = true;
-                        break;
+                        cgEd->selectedNodesCount--;
                     }
+                    nodeAlreadySelected = true;
+                    break;
                 }
-                if (!nodeAlreadySelected)
+            }
+            if (!nodeAlreadySelected)
+            {
+                if (!IsKeyDown(KEY_LEFT_CONTROL))
                 {
-                    if (!IsKeyDown(KEY_LEFT_CONTROL))
-                    {
-                        cgEd->selectedNodesCount = 0;
-                    }
-                    cgEd->selectedNodes[cgEd->selectedNodesCount] = i;
-                    cgEd->selectedNodesCount++;
+                    cgEd->selectedNodesCount = 0;
                 }
-                return;
+                cgEd->selectedNodes[cgEd->selectedNodesCount] = i;
+                cgEd->selectedNodesCount++;
             }
+            return;
         }
 
         if (!cgEd->isNodeOptionsMenuOpen)
@@ -1569,8 +1683,7 @@ void HandleDragging(CGEditorContext *cgEd, GraphContext *graph)
         {
             for (int i = 0; i < cgEd->selectedNodesCount; i++)
             {
-                graph->nodes[cgEd->selectedNodes[i]].position.x += delta.x / cgEd->zoom;
-                graph->nodes[cgEd->selectedNodes[i]].position.y += delta.y / cgEd->zoom;
+                MoveNode(graph, cgEd->selectedNodes[i], Vector2Scale(delta, 1.0f / cgEd->zoom));
             }
         }
     }
@@ -1578,12 +1691,7 @@ void HandleDragging(CGEditorContext *cgEd, GraphContext *graph)
     {
         cgEd->cursor = MOUSE_CURSOR_RESIZE_ALL;
         Vector2 delta = Vector2Scale(GetMouseDelta(), 1.0f / cgEd->zoom);
-        for (int i = 0; i < graph->nodeCount; i++)
-        {
-
-            graph->nodes[i].position.x += delta.x;
-            graph->nodes[i].position.y += delta.y;
-        }
+        cgEd->camera.target = Vector2Subtract(cgEd->camera.target, delta);
     }
     else if (IsMouseButtonUp(MOUSE_LEFT_BUTTON))
     {
@@ -1616,6 +1724,8 @@ void DrawFullTexture(CGEditorContext *cgEd, GraphContext *graph, RenderTexture2D
 
     DrawBackgroundGrid(cgEd, 40, dot);
 
+    BeginMode2D(cgEd->camera);
+
     DrawNodes(cgEd, graph);
 
     if (cgEd->isSelecting)
@@ -1626,14 +1736,11 @@ void DrawFullTexture(CGEditorContext *cgEd, GraphContext *graph, RenderTexture2D
         DrawRectangleLinesEx(selectorRect, 2.0f, COLOR_CGED_SELECTOR_OUTLINE);
 
         cgEd->selectedNodesCount = 0;
-        for (int i = 0; i < graph->nodeCount; i++)
+        int hitCount = QueryNodesInRect(graph, selectorRect);
+        for (int i = 0; i < hitCount && cgEd->selectedNodesCount < MAX_SELECTED_NODES; i++)
         {
-            Rectangle nodeRect = (Rectangle){graph->nodes[i].position.x, graph->nodes[i].position.y, getNodeInfoByType(graph->nodes[i].type, INFO_NODE_WIDTH), getNodeInfoByType(graph->nodes[i].type, INFO_NODE_HEIGHT)};
-            if (CheckCollisionRecs(nodeRect, selectorRect))
-            {
-                cgEd->selectedNodes[cgEd->selectedNodesCount] = i;
-                cgEd->selectedNodesCount++;
-            }
+            cgEd->selectedNodes[cgEd->selectedNodesCount] = graph->nodeGrid.results[i];
+            cgEd->selectedNodesCount++;
         }
     }
 
@@ -1715,9 +1822,28 @@ void DrawFullTexture(CGEditorContext *cgEd, GraphContext *graph, RenderTexture2D
         }
     }
 
+    EndMode2D();
+
     EndTextureMode();
 }
 
+void FocusEditorOnNode(CGEditorContext *cgEd, GraphContext *graph, int nodeIndex)
+{
+    if (nodeIndex < 0 || nodeIndex >= graph->nodeCount)
+    {
+        return;
+    }
+
+    Node *node = &graph->nodes[nodeIndex];
+    Vector2 nodeCenter = {node->position.x + getNodeInfoByType(node->type, INFO_NODE_WIDTH) / 2.0f, node->position.y + getNodeInfoByType(node->type, INFO_NODE_HEIGHT) / 2.0f};
+    Vector2 viewCenter = {cgEd->viewportBoundary.x + cgEd->viewportBoundary.width / 2, cgEd->viewportBoundary.y + cgEd->viewportBoundary.height / 2};
+    cgEd->camera.target = Vector2Add(cgEd->camera.target, Vector2Subtract(nodeCenter, viewCenter));
+
+    cgEd->selectedNodes[0] = nodeIndex;
+    cgEd->selectedNodesCount = 1;
+    cgEd->delayFrames = true;
+}
+
 bool CheckOpenMenus(CGEditorContext *cgEd)
 {
     return cgEd->isDraggingSelectedNodes || cgEd->lastClickedPin.id != -1 || cgEd->isNodeCreateMenuOpen || cgEd->focusedDropdownPin != -1 || cgEd->focusedFieldPin != -1 || cgEd->editingNodeNameIndex != -1;
@@ -1728,9 +1854,17 @@ void HandleEditor(CGEditorContext *cgEd, GraphContext *graph, RenderTexture2D *v
     cgEd->newLogMessage = false;
     cgEd->cursor = MOUSE_CURSOR_ARROW;
 
+    if (!VerifyMappedArrays(graph))
+    {
+        AddToLogFromCGEditor(cgEd, "Graph file is damaged, continuing with empty graph{C224}", LOG_LEVEL_ERROR);
+    }
+
     cgEd->screenWidth = viewport->texture.width;
     cgEd->screenHeight = viewport->texture.height;
-    cgEd->mousePos = mousePos;
+    cgEd->camera.zoom = cgEd->zoom < CGED_MIN_TEXTURE_ZOOM ? cgEd->zoom / CGED_MIN_TEXTURE_ZOOM : 1.0f;
+    cgEd->mousePos = GetScreenToWorld2D(mousePos, cgEd->camera);
+    Vector2 boundaryTopLeft = GetScreenToWorld2D((Vector2){cgEd->viewportBoundary.x, cgEd->viewportBoundary.y}, cgEd->camera);
+    cgEd->viewportBoundary = (Rectangle){boundaryTopLeft.x, boundaryTopLeft.y, cgEd->viewportBoundary.width / cgEd->camera.zoom, cgEd->viewportBoundary.height / cgEd->camera.zoom};
 
     cgEd->isLMBPressed = IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && !draggingDisabled;
 
@@ -13,6 +13,43 @@
 
 #define MAX_SELECTED_NODES 1000
 
+// The viewport texture is twice the screen size, so the engine can not zoom it out further than this.
+// Editor zoom below it is done by the camera instead
+#define CGED_MIN_TEXTURE_ZOOM 0.5f
+#define CGED_MIN_ZOOM 0.25f
+
+// Zoom levels where DrawNodes switches detail tiers. Going back up needs NODE_LOD_HYSTERESIS more zoom, so the tier
+// does not flicker around a threshold
+#define NODE_LOD_SIMPLE_ZOOM 0.7f
+#define NODE_LOD_FLAT_ZOOM 0.45f
+#define NODE_LOD_HYSTERESIS 0.1f
+
+typedef enum
+{
+    NODE_LOD_FULL,
+    // No text, pins or fields, simpler wires
+    NODE_LOD_SIMPLE,
+    // Flat coloured boxes and straight wires
+    NODE_LOD_FLAT
+} NodeLOD;
+
+// Both straight ends and up to 64 bezier segments in between
+#define MAX_WIRE_POINTS 67
+
+// Tessellated wire of a link, redone only when one of its pins moves
+typedef struct
+{
+    Vector2 outputPos;
+    Vector2 inputPos;
+    bool isLowSpecModeOn;
+    bool isValid;
+
+    // The first and last segment are the straight ends, the glow is only drawn along the curve between them
+    Vector2 points[MAX_WIRE_POINTS];
+    int pointCount;
+    Rectangle bounds;
+} WireGeometry;
+
 typedef struct
 {
     int screenWidth;
@@ -64,6 +101,11 @@ typedef struct
     int fps;
 
     float zoom;
+    NodeLOD lod;
+
+    // Pans the view without moving nodes. Node positions, mousePos and viewportBoundary are in graph coordinates.
+    // The camera only zooms when cgEd->zoom is below CGED_MIN_TEXTURE_ZOOM, the rest is applied when the viewport texture is drawn
+    Camera2D camera;
 
     Rectangle viewportBoundary;
 
@@ -94,6 +136,15 @@ typedef struct
     int hoveredNodeIndex;
     int hoveredPinIndex;
 
+    // Nodes drawn in the last frame, only their pins are drawn and hit tested
+    int *visibleNodes;
+    int visibleNodeCount;
+    int visibleNodeCapacity;
+
+    // Indexed by link, entries are checked against the pin positions before use so links can move around freely
+    WireGeometry *wires;
+    int wireCapacity;
+
     GraphContext *graph;
 } CGEditorContext;
 
@@ -101,4 +152,7 @@ CGEditorContext InitEditorContext(void);
 
 void FreeEditorContext(CGEditorContext *editor);
 
-void HandleEditor(CGEditorContext *editor, GraphContext *graph, RenderTexture2D *viewport, Vector2 mousePos, bool draggingDisabled);
\ No newline at end of file
+void HandleEditor(CGEditorContext *editor, GraphContext *graph, RenderTexture2D *viewport, Vector2 mousePos, bool draggingDisabled);
+
+// Pans the view so the node is in the middle of the viewport and selects it
+void FocusEditorOnNode(CGEditorContext *editor, GraphContext *graph, int nodeIndex);
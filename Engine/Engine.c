@@ -280,6 +280,7 @@ void EmergencyExit(EngineContext *eng, CGEditorContext *cgEd, InterpreterContext
     FreeEngineContext(eng);
     FreeEditorContext(cgEd);
     FreeInterpreterContext(intp);
+    FreeArena(&intp->arena);
     FreeTextEditorContext(txEd);
 
     free(intp->projectPath);
@@ -568,6 +569,11 @@ bool SaveSettings(EngineContext *eng, InterpreterContext *intp, CGEditorContext
     fprintf(fptr, "\nInterpreter:\n\n");
     fprintf(fptr, "InfiniteLoopProtection=%s\n", intp->isInfiniteLoopProtectionOn ? "true" : "false");
     fprintf(fptr, "ShowHitboxes=%s\n", intp->shouldShowHitboxes ? "true" : "false");
+    fprintf(fptr, "BytecodeVM=%s\n", intp->isBytecodeVMOn ? "true" : "false");
+    fprintf(fptr, "FixedTimestep=%s\n", intp->isFixedTimestepOn ? "true" : "false");
+#ifdef RAPID_PROFILER
+    fprintf(fptr, "Profiler=%s\n", intp->profiler.isOn ? "true" : "false");
+#endif
 
     fclose(fptr);
     return true;
@@ -640,6 +646,20 @@ bool LoadSettingsConfig(EngineContext *eng, InterpreterContext *intp, CGEditorCo
         {
             intp->shouldShowHitboxes = strcmp(value, "true") == 0 ? true : false;
         }
+        else if (strcmp(key, "BytecodeVM") == 0)
+        {
+            intp->isBytecodeVMOn = strcmp(value, "true") == 0 ? true : false;
+        }
+        else if (strcmp(key, "FixedTimestep") == 0)
+        {
+            intp->isFixedTimestepOn = strcmp(value, "true") == 0 ? true : false;
+        }
+#ifdef RAPID_PROFILER
+        else if (strcmp(key, "Profiler") == 0)
+        {
+            intp->profiler.isOn = strcmp(value, "true") == 0 ? true : false;
+        }
+#endif
     }
 
     fclose(fptr);
@@ -821,6 +841,23 @@ bool DrawSettingsMenu(EngineContext *eng, InterpreterContext *intp, CGEditorCont
 
         DrawTextEx(eng->font, "Hide Mouse Cursor in Fullscreen", (Vector2){eng->screenWidth / 4 + 200, 400}, 28, 1, WHITE);
         DrawSlider((Vector2){eng->screenWidth * 3 / 4 - 70, 403}, &eng->shouldHideCursorInGameFullscreen, eng->mousePos, &hasChanged);
+
+        DrawLine(eng->screenWidth / 4 + 182, 440, eng->screenWidth * 3 / 4, 440, GRAY_50);
+
+        DrawTextEx(eng->font, "Bytecode VM", (Vector2){eng->screenWidth / 4 + 200, 450}, 28, 1, WHITE);
+        DrawSlider((Vector2){eng->screenWidth * 3 / 4 - 70, 453}, &intp->isBytecodeVMOn, eng->mousePos, &hasChanged);
+
+        DrawLine(eng->screenWidth / 4 + 182, 490, eng->screenWidth * 3 / 4, 490, GRAY_50);
+
+        DrawTextEx(eng->font, "Fixed Timestep", (Vector2){eng->screenWidth / 4 + 200, 500}, 28, 1, WHITE);
+        DrawSlider((Vector2){eng->screenWidth * 3 / 4 - 70, 503}, &intp->isFixedTimestepOn, eng->mousePos, &hasChanged);
+#ifdef RAPID_PROFILER
+
+        DrawLine(eng->screenWidth / 4 + 182, 540, eng->screenWidth * 3 / 4, 540, GRAY_50);
+
+        DrawTextEx(eng->font, "Profiler Overlay", (Vector2){eng->screenWidth / 4 + 200, 550}, 28, 1, WHITE);
+        DrawSlider((Vector2){eng->screenWidth * 3 / 4 - 70, 553}, &intp->profiler.isOn, eng->mousePos, &hasChanged);
+#endif
         break;
     case SETTINGS_MODE_KEYBINDS:
         DrawTextEx(eng->font, "No Keybind settings yet!", (Vector2){eng->screenWidth / 4 + 200, 300}, 28, 1, RED);
@@ -1000,6 +1037,10 @@ void DrawUIElements(EngineContext *eng, GraphContext *graph, CGEditorContext *cg
                 }
                 *runtimeGraph = ConvertToRuntimeGraph(graph, intp);
                 intp->runtimeGraph = runtimeGraph;
+                if (!intp->buildFailed && !intp->buildErrorOccured)
+                {
+                    CompileRuntimeGraph(intp, runtimeGraph);
+                }
                 if (intp->buildFailed)
                 {
                     EmergencyExit(eng, cgEd, intp, txEd);
@@ -1234,7 +1275,7 @@ void DrawUIElements(EngineContext *eng, GraphContext *graph, CGEditorContext *cg
                                   .color = DARKGRAY,
                                   .layer = 1,
                                   .text = {.textPos = {eng->sideBarWidth + 10, eng->uiElements[eng->hoveredUIElementIndex].rect.pos.y + 10}, .textSize = 20, .textSpacing = 0, .textColor = WHITE}});
-            strmac(eng->uiElements[eng->uiElementCount - 1].text.string, MAX_VARIABLE_TOOLTIP_SIZE, "%s %s = %s", ValueTypeToString(intp->values[eng->uiElements[eng->hoveredUIElementIndex].valueIndex].type), intp->values[eng->uiElements[eng->hoveredUIElementIndex].valueIndex].name, ValueToString(intp->values[eng->uiElements[eng->hoveredUIElementIndex].valueIndex]));
+            strmac(eng->uiElements[eng->uiElementCount - 1].text.string, MAX_VARIABLE_TOOLTIP_SIZE, "%s %s = %s", ValueTypeToString(intp->values[eng->uiElements[eng->hoveredUIElementIndex].valueIndex].type), intp->valueNames[eng->uiElements[eng->hoveredUIElementIndex].valueIndex], ValueToString(intp, intp->values[eng->uiElements[eng->hoveredUIElementIndex].valueIndex]));
             eng->uiElements[eng->uiElementCount - 1].rect.recSize.x = MeasureTextEx(eng->font, eng->uiElements[eng->uiElementCount - 1].text.string, 20, 0).x + 20;
             break;
 
@@ -1664,7 +1705,7 @@ void BuildUITexture(EngineContext *eng, GraphContext *graph, CGEditorContext *cg
 
         char varName[MAX_VARIABLE_NAME_SIZE];
 
-        strmac(varName, MAX_VARIABLE_NAME_SIZE, "%s", eng->isGameRunning ? intp->values[i].name : graph->variables[i]);
+        strmac(varName, MAX_VARIABLE_NAME_SIZE, "%s", eng->isGameRunning ? intp->valueNames[i] : graph->variables[i]);
         bool textHidden = false;
         if (eng->sideBarHalfSnap || ellipsisSize > eng->sideBarWidth - 80 - 20)
         {
@@ -2083,6 +2124,10 @@ bool HandleUICollisions(EngineContext *eng, GraphContext *graph, InterpreterCont
         {
             *runtimeGraph = ConvertToRuntimeGraph(graph, intp);
             intp->runtimeGraph = runtimeGraph;
+            if (!intp->buildFailed && !intp->buildErrorOccured)
+            {
+                CompileRuntimeGraph(intp, runtimeGraph);
+            }
             if (intp->buildFailed)
             {
                 EmergencyExit(eng, cgEd, intp, txEd);
@@ -2562,26 +2607,27 @@ void SetEngineZoom(EngineContext *eng, CGEditorContext *cgEd, InterpreterContext
 {
     if (eng->viewportMode == VIEWPORT_CG_EDITOR)
     {
-        eng->zoom = cgEd->zoom;
         float wheel = GetMouseWheelMove();
         if (wheel != 0 && eng->isViewportFocused && !cgEd->isNodeCreateMenuOpen)
         {
             cgEd->delayFrames = true;
 
-            float zoom = eng->zoom;
+            float zoom = cgEd->zoom;
 
+            // Finer steps when zoomed out, where each step changes how much of the graph fits a lot more
             if (wheel > 0 && zoom < 1.5f)
             {
-                eng->zoom = zoom + 0.25f;
+                cgEd->zoom = zoom + (zoom < 1.0f ? 0.125f : 0.25f);
             }
 
-            if (wheel < 0 && zoom > 0.5f)
+            if (wheel < 0 && zoom > CGED_MIN_ZOOM)
             {
-                eng->zoom = zoom - 0.25f;
+                cgEd->zoom = zoom - (zoom <= 1.0f ? 0.125f : 0.25f);
             }
-
-            cgEd->zoom = eng->zoom;
         }
+
+        // Zooming out past what the viewport texture allows is left to the editor camera
+        eng->zoom = fmaxf(cgEd->zoom, CGED_MIN_TEXTURE_ZOOM);
     }
     else if (eng->viewportMode == VIEWPORT_GAME_SCREEN)
     {
@@ -2595,6 +2641,72 @@ void SetEngineZoom(EngineContext *eng, CGEditorContext *cgEd, InterpreterContext
     }
 }
 
+#ifdef RAPID_PROFILER
+// Drawn over the game, returns the node whose row was clicked or -1
+int DrawProfilerOverlay(EngineContext *eng, InterpreterContext *intp, Vector2 mousePos, Rectangle viewport)
+{
+    Profiler *profiler = &intp->profiler;
+
+    const int rowHeight = 20;
+    const int width = 330;
+    int rowCount = 3 + PROFILER_SECTION_COUNT + profiler->shownNodeTypeCount + profiler->hotNodeCount;
+    Rectangle panel = {viewport.x + viewport.width - width - 10, viewport.y + 10, width, rowCount * rowHeight + 20};
+    DrawRectangleRounded(panel, 0.05f, 4, COLOR_INTP_PROFILER_BACKGROUND);
+
+    float x = panel.x + 10;
+    float y = panel.y + 10;
+
+    if (profiler->shownFrameSeconds == 0)
+    {
+        DrawTextEx(eng->font, "Profiling...", (Vector2){x, y}, 20, 1, WHITE);
+        return -1;
+    }
+
+    DrawTextEx(eng->font, TextFormat("Frame %.2f ms (%d frame average)", profiler->shownFrameSeconds * 1e3, PROFILER_WINDOW_FRAMES), (Vector2){x, y}, 20, 1, WHITE);
+    y += rowHeight;
+
+    for (int s = 0; s < PROFILER_SECTION_COUNT; s++)
+    {
+        DrawTextEx(eng->font, TextFormat("%-12s %8.3f ms", ProfilerSectionToString(s), profiler->shownSectionSeconds[s] * 1e3), (Vector2){x, y}, 20, 1, LIGHTGRAY);
+        y += rowHeight;
+    }
+
+    DrawTextEx(eng->font, "Node types", (Vector2){x, y}, 20, 1, WHITE);
+    y += rowHeight;
+    for (int t = 0; t < profiler->shownNodeTypeCount; t++)
+    {
+        ProfilerNodeTypeStats *stats = &profiler->shownNodeTypes[t];
+        DrawTextEx(eng->font, TextFormat("%-16s %8.3f ms %7.0f/frame", NodeTypeToString(stats->type), stats->seconds * 1e3, stats->executionsPerFrame), (Vector2){x, y}, 20, 1, LIGHTGRAY);
+        y += rowHeight;
+    }
+
+    DrawTextEx(eng->font, "Hottest nodes, click to open", (Vector2){x, y}, 20, 1, WHITE);
+    y += rowHeight;
+
+    int clickedNodeIndex = -1;
+    for (int i = 0; i < profiler->hotNodeCount; i++)
+    {
+        ProfilerHotNode *hotNode = &profiler->hotNodes[i];
+        Rectangle row = {panel.x, y, panel.width, rowHeight};
+        if (CheckCollisionPointRec(mousePos, row))
+        {
+            DrawRectangleRec(row, COLOR_INTP_PROFILER_ROW_HOVER);
+            SetMouseCursor(MOUSE_CURSOR_POINTING_HAND);
+            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+            {
+                clickedNodeIndex = hotNode->nodeIndex;
+            }
+        }
+
+        const char *typeName = hotNode->nodeIndex < profiler->nodeCount ? NodeTypeToString(profiler->nodeTypes[hotNode->nodeIndex]) : "";
+        DrawTextEx(eng->font, TextFormat("#%-4d %-12s %8.3f ms %7.0f/frame", hotNode->nodeIndex, typeName, hotNode->seconds * 1e3, hotNode->executionsPerFrame), (Vector2){x, y}, 20, 1, LIGHTGRAY);
+        y += rowHeight;
+    }
+
+    return clickedNodeIndex;
+}
+#endif
+
 void DisplayLoadingScreen(int step)
 {
     BeginDrawing();
@@ -2826,8 +2938,23 @@ int main(int argc, char **argv)
 
             eng.isGameRunning = HandleGameScreen(&intp, &runtimeGraph, mouseInViewportTex, viewportRecInViewportTex);
 
+#ifdef RAPID_PROFILER
+            int profiledNodeIndex = eng.isGameRunning && intp.profiler.isOn ? DrawProfilerOverlay(&eng, &intp, mouseInViewportTex, viewportRecInViewportTex) : -1;
+#endif
+
             EndTextureMode();
 
+#ifdef RAPID_PROFILER
+            // Stops the game like Ctrl+E and shows the node in the editor
+            if (profiledNodeIndex != -1)
+            {
+                eng.isGameRunning = false;
+                eng.isViewportFullscreen = false;
+                eng.delayFrames = true;
+                FocusEditorOnNode(&cgEd, &graph, profiledNodeIndex);
+            }
+#endif
+
             if (intp.newLogMessage)
             {
                 for (int i = 0; i < intp.logMessageCount; i++)
@@ -3007,6 +3134,7 @@ int main(int argc, char **argv)
     FreeEngineContext(&eng);
     FreeEditorContext(&cgEd);
     FreeInterpreterContext(&intp);
+    FreeArena(&intp.arena);
     FreeTextEditorContext(&txEd);
 
     CloseAudioDevice();
@@ -0,0 +1,90 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#include <string.h>
+#include "HashIndex.h"
+
+unsigned int HashBytes(const char *bytes, int length)
+{
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < length; i++)
+    {
+        hash ^= (unsigned char)bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void PlaceInSlots(HashIndexSlot *slots, int slotCapacity, HashIndexSlot entry)
+{
+    int slot = entry.hash & (slotCapacity - 1);
+    while (slots[slot].id != HASH_INDEX_NONE)
+    {
+        slot = (slot + 1) & (slotCapacity - 1);
+    }
+    slots[slot] = entry;
+}
+
+int FindInHashIndex(const HashIndex *index, const char *key, int length, unsigned int hash)
+{
+    if (index->slotCapacity == 0)
+    {
+        return HASH_INDEX_NONE;
+    }
+
+    int slot = hash & (index->slotCapacity - 1);
+    while (index->slots[slot].id != HASH_INDEX_NONE)
+    {
+        const HashIndexSlot *entry = &index->slots[slot];
+        if (entry->hash == hash && entry->length == length && memcmp(entry->key, key, length) == 0)
+        {
+            return entry->id;
+        }
+        slot = (slot + 1) & (index->slotCapacity - 1);
+    }
+    return HASH_INDEX_NONE;
+}
+
+bool ReserveHashIndex(HashIndex *index)
+{
+    if ((index->count + 1) * 2 <= index->slotCapacity)
+    {
+        return true;
+    }
+
+    int newSlotCapacity = index->slotCapacity ? index->slotCapacity * 2 : HASH_INDEX_INITIAL_CAPACITY;
+    HashIndexSlot *newSlots = malloc(sizeof(HashIndexSlot) * newSlotCapacity);
+    if (!newSlots)
+    {
+        return false;
+    }
+    for (int i = 0; i < newSlotCapacity; i++)
+    {
+        newSlots[i].id = HASH_INDEX_NONE;
+    }
+
+    for (int i = 0; i < index->slotCapacity; i++)
+    {
+        if (index->slots[i].id != HASH_INDEX_NONE)
+        {
+            PlaceInSlots(newSlots, newSlotCapacity, index->slots[i]);
+        }
+    }
+
+    free(index->slots);
+    index->slots = newSlots;
+    index->slotCapacity = newSlotCapacity;
+    return true;
+}
+
+void InsertIntoHashIndex(HashIndex *index, const char *key, int length, unsigned int hash, int id)
+{
+    PlaceInSlots(index->slots, index->slotCapacity, (HashIndexSlot){.key = key, .length = length, .hash = hash, .id = id});
+    index->count++;
+}
+
+void FreeHashIndex(HashIndex *index)
+{
+    free(index->slots);
+    *index = (HashIndex){0};
+}
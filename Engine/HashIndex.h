@@ -0,0 +1,47 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#ifdef RAPID_HEADLESS
+#include "Headless.h"
+#endif
+
+#define HASH_INDEX_INITIAL_CAPACITY 32
+
+// Returned when a key is not in the index, and the ID of empty slots
+#define HASH_INDEX_NONE -1
+
+typedef struct
+{
+    const char *key;
+    int length;
+    unsigned int hash;
+    int id;
+} HashIndexSlot;
+
+// Open addressing index from byte strings to IDs, shared by the string table, texture cache and sound bank.
+// Keys are not copied, so they have to stay valid while they are in the index. Kept at most half full
+typedef struct
+{
+    HashIndexSlot *slots;
+    int slotCapacity;
+    int count;
+} HashIndex;
+
+// FNV-1a
+unsigned int HashBytes(const char *bytes, int length);
+
+// ID stored for key, HASH_INDEX_NONE if there is none
+int FindInHashIndex(const HashIndex *index, const char *key, int length, unsigned int hash);
+
+// Makes room for one more key, false if out of memory
+bool ReserveHashIndex(HashIndex *index);
+
+// Call ReserveHashIndex first. The key must not be in the index already
+void InsertIntoHashIndex(HashIndex *index, const char *key, int length, unsigned int hash, int id);
+
+void FreeHashIndex(HashIndex *index);
@@ -0,0 +1,321 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+// Runs a CoreGraph project without a window and reports interpreter throughput.
+// Usage: RapidEngineHeadless <graph.cg> [ticks] [--reference] [--fixed]
+
+#include "Interpreter.h"
+
+// Allocations made by the runner itself are not counted
+#undef malloc
+#undef calloc
+#undef realloc
+#undef strdup
+#undef free
+
+#define HEADLESS_DEFAULT_TICKS 10000
+#define HEADLESS_TICKS_PER_SECOND 60
+#define HEADLESS_SCREEN_WIDTH 1280
+#define HEADLESS_SCREEN_HEIGHT 720
+
+bool STRING_ALLOCATION_FAILURE = false;
+
+AllocationStats headlessAllocationStats = {0};
+
+void *HeadlessMalloc(size_t size)
+{
+    headlessAllocationStats.allocations++;
+    headlessAllocationStats.bytesRequested += size;
+    return malloc(size);
+}
+
+void *HeadlessCalloc(size_t count, size_t size)
+{
+    headlessAllocationStats.allocations++;
+    headlessAllocationStats.bytesRequested += count * size;
+    return calloc(count, size);
+}
+
+void *HeadlessRealloc(void *ptr, size_t size)
+{
+    headlessAllocationStats.reallocations++;
+    headlessAllocationStats.bytesRequested += size;
+    return realloc(ptr, size);
+}
+
+char *HeadlessStrdup(const char *str)
+{
+    headlessAllocationStats.allocations++;
+    headlessAllocationStats.bytesRequested += strlen(str) + 1;
+    return strdup(str);
+}
+
+void HeadlessFree(void *ptr)
+{
+    if (ptr)
+    {
+        headlessAllocationStats.frees++;
+    }
+    free(ptr);
+}
+
+typedef struct
+{
+    double buildSeconds;
+    AllocationStats buildAllocations;
+
+    double runSeconds;
+    int ticksRun;
+    AllocationStats runAllocations;
+
+    int logMessageCount;
+    int errorCount;
+
+    int textureCount;
+    int textureFailures;
+    int textureHits;
+    int textureMisses;
+} HeadlessReport;
+
+typedef struct
+{
+    NodeType type;
+    double seconds;
+    long long executionCount;
+} NodeTypeStats;
+
+static AllocationStats AllocationsSince(AllocationStats start)
+{
+    return (AllocationStats){
+        .allocations = headlessAllocationStats.allocations - start.allocations,
+        .reallocations = headlessAllocationStats.reallocations - start.reallocations,
+        .frees = headlessAllocationStats.frees - start.frees,
+        .bytesRequested = headlessAllocationStats.bytesRequested - start.bytesRequested};
+}
+
+static void FlushLog(InterpreterContext *intp, HeadlessReport *report, bool shouldPrint)
+{
+    for (int i = 0; i < intp->logMessageCount; i++)
+    {
+        report->logMessageCount++;
+        if (intp->logMessageLevels[i] == LOG_LEVEL_ERROR)
+        {
+            report->errorCount++;
+        }
+        if (shouldPrint && intp->logMessageLevels[i] != LOG_LEVEL_NORMAL && intp->logMessageLevels[i] != LOG_LEVEL_DEBUG)
+        {
+            printf("[%s] %s\n", intp->logMessageLevels[i] == LOG_LEVEL_ERROR ? "error" : "warning", intp->logMessages[i]);
+        }
+    }
+    intp->logMessageCount = 0;
+    intp->newLogMessage = false;
+}
+
+static bool RunGraph(GraphContext *graph, char *projectPath, int ticks, bool isBytecodeVMOn, bool isFixedTimestepOn, NodeStats *nodeStats, bool shouldPrintLog, HeadlessReport *report)
+{
+    InterpreterContext intp = InitInterpreterContext();
+    intp.projectPath = projectPath;
+    intp.isBytecodeVMOn = isBytecodeVMOn;
+    intp.isFixedTimestepOn = isFixedTimestepOn;
+
+    srand(0);
+
+    AllocationStats startAllocations = headlessAllocationStats;
+    double startTime = GetTime();
+
+    RuntimeGraphContext runtimeGraph = ConvertToRuntimeGraph(graph, &intp);
+    intp.runtimeGraph = &runtimeGraph;
+    if (!intp.buildFailed && !intp.buildErrorOccured)
+    {
+        CompileRuntimeGraph(&intp, &runtimeGraph);
+    }
+
+    report->buildSeconds = GetTime() - startTime;
+    report->buildAllocations = AllocationsSince(startAllocations);
+
+    FlushLog(&intp, report, shouldPrintLog);
+    if (intp.buildFailed || intp.buildErrorOccured)
+    {
+        FreeInterpreterContext(&intp);
+        FreeArena(&intp.arena);
+        return false;
+    }
+
+    intp.nodeStats = nodeStats;
+
+    Rectangle screenBoundary = {0, 0, HEADLESS_SCREEN_WIDTH, HEADLESS_SCREEN_HEIGHT};
+
+    startAllocations = headlessAllocationStats;
+    startTime = GetTime();
+
+    report->ticksRun = 0;
+    while (report->ticksRun < ticks)
+    {
+        bool isGameRunning = HandleGameScreen(&intp, &runtimeGraph, (Vector2){0, 0}, screenBoundary);
+        if (intp.newLogMessage)
+        {
+            FlushLog(&intp, report, shouldPrintLog);
+        }
+        if (!isGameRunning)
+        {
+            break;
+        }
+        report->ticksRun++;
+    }
+
+    report->runSeconds = GetTime() - startTime;
+    report->runAllocations = AllocationsSince(startAllocations);
+
+    report->textureCount = intp.textures.count - intp.textures.failures;
+    report->textureFailures = intp.textures.failures;
+    report->textureHits = intp.textures.hits;
+    report->textureMisses = intp.textures.misses;
+
+    FreeInterpreterContext(&intp);
+    FreeArena(&intp.arena);
+    return true;
+}
+
+static void PrintAllocations(const char *label, AllocationStats stats)
+{
+    printf("Allocs:  %s: %lld allocations, %lld reallocations, %lld frees, %zu bytes requested\n", label, stats.allocations, stats.reallocations, stats.frees, stats.bytesRequested);
+}
+
+static int CompareNodeTypeStats(const void *a, const void *b)
+{
+    double difference = ((const NodeTypeStats *)b)->seconds - ((const NodeTypeStats *)a)->seconds;
+    return (difference > 0) - (difference < 0);
+}
+
+static void PrintNodeTypeStats(GraphContext *graph, NodeStats *nodeStats, int ticks)
+{
+    NodeTypeStats *typeStats = calloc(graph->nodeCount, sizeof(NodeTypeStats));
+    if (!typeStats)
+    {
+        return;
+    }
+
+    int typeCount = 0;
+    for (int i = 0; i < graph->nodeCount; i++)
+    {
+        if (nodeStats[i].executionCount == 0)
+        {
+            continue;
+        }
+
+        int t = 0;
+        while (t < typeCount && typeStats[t].type != graph->nodes[i].type)
+        {
+            t++;
+        }
+        if (t == typeCount)
+        {
+            typeStats[typeCount++].type = graph->nodes[i].type;
+        }
+        typeStats[t].seconds += nodeStats[i].seconds;
+        typeStats[t].executionCount += nodeStats[i].executionCount;
+    }
+
+    qsort(typeStats, typeCount, sizeof(NodeTypeStats), CompareNodeTypeStats);
+
+    printf("\nPer node type (tree walker, %d ticks):\n", ticks);
+    printf("  %-24s %14s %12s %10s\n", "Node", "Executions", "Total ms", "ns/exec");
+    for (int t = 0; t < typeCount; t++)
+    {
+        printf("  %-24s %14lld %12.3f %10.1f\n", NodeTypeToString(typeStats[t].type), typeStats[t].executionCount, typeStats[t].seconds * 1e3, typeStats[t].seconds * 1e9 / typeStats[t].executionCount);
+    }
+
+    free(typeStats);
+}
+
+int main(int argc, char **argv)
+{
+    const char *graphPath = NULL;
+    int ticks = HEADLESS_DEFAULT_TICKS;
+    bool isBytecodeVMOn = true;
+    bool isFixedTimestepOn = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--reference") == 0)
+        {
+            isBytecodeVMOn = false;
+        }
+        else if (strcmp(argv[i], "--fixed") == 0)
+        {
+            isFixedTimestepOn = true;
+        }
+        else if (!graphPath)
+        {
+            graphPath = argv[i];
+        }
+        else
+        {
+            ticks = atoi(argv[i]);
+        }
+    }
+
+    if (!graphPath || ticks <= 0)
+    {
+        fprintf(stderr, "Usage: %s <graph.cg> [ticks] [--reference] [--fixed]\n", argv[0]);
+        return 1;
+    }
+
+    char projectPath[MAX_FILE_PATH];
+    strmac(projectPath, MAX_FILE_PATH, "%s", graphPath);
+    char *lastSeparator = strrchr(projectPath, '/');
+    char *lastBackslash = strrchr(projectPath, '\\');
+    if (lastBackslash > lastSeparator)
+    {
+        lastSeparator = lastBackslash;
+    }
+    if (lastSeparator)
+    {
+        *lastSeparator = '\0';
+    }
+    else
+    {
+        strmac(projectPath, MAX_FILE_PATH, ".");
+    }
+
+    SetHeadlessTimestep(1.0f / HEADLESS_TICKS_PER_SECOND);
+
+    GraphContext graph = InitGraphContext();
+    if (!LoadGraphFromFile(graphPath, &graph))
+    {
+        fprintf(stderr, "Failed to load %s\n", graphPath);
+        return 1;
+    }
+
+    HeadlessReport report = {0};
+    if (!RunGraph(&graph, projectPath, ticks, isBytecodeVMOn, isFixedTimestepOn, NULL, true, &report))
+    {
+        fprintf(stderr, "Build failed\n");
+        FreeGraphContext(&graph);
+        return 1;
+    }
+
+    printf("\nGraph:   %s (%d nodes)\n", graphPath, graph.nodeCount);
+    printf("Mode:    %s, %s\n", isBytecodeVMOn ? "bytecode VM" : "tree walker", isFixedTimestepOn ? TextFormat("fixed %d Hz timestep", FIXED_TICK_RATE) : "one step per frame");
+    printf("Build:   %.3f ms\n", report.buildSeconds * 1e3);
+    printf("Run:     %d ticks in %.3f ms, %.0f ticks/sec\n", report.ticksRun, report.runSeconds * 1e3, report.runSeconds > 0 ? report.ticksRun / report.runSeconds : 0.0);
+    printf("Log:     %d messages, %d errors\n", report.logMessageCount, report.errorCount);
+    printf("Texture: %d loaded, %d failed, %d cache hits, %d misses\n", report.textureCount, report.textureFailures, report.textureHits, report.textureMisses);
+    PrintAllocations("build", report.buildAllocations);
+    PrintAllocations("run", report.runAllocations);
+
+    // Per node timing needs every node executed on its own, so it is taken in a second pass on the tree walker
+    NodeStats *nodeStats = calloc(graph.nodeCount, sizeof(NodeStats));
+    if (nodeStats)
+    {
+        HeadlessReport profileReport = {0};
+        if (RunGraph(&graph, projectPath, ticks, false, isFixedTimestepOn, nodeStats, false, &profileReport))
+        {
+            PrintNodeTypeStats(&graph, nodeStats, profileReport.ticksRun);
+        }
+        free(nodeStats);
+    }
+
+    FreeGraphContext(&graph);
+    return report.errorCount > 0 ? 1 : 0;
+}
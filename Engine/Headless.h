@@ -0,0 +1,34 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <stdlib.h>
+#include <string.h>
+
+// Only included by the RapidEngineHeadless target (RAPID_HEADLESS), so the editor build is untouched
+
+typedef struct
+{
+    long long allocations;
+    long long reallocations;
+    long long frees;
+    size_t bytesRequested;
+} AllocationStats;
+
+extern AllocationStats headlessAllocationStats;
+
+void *HeadlessMalloc(size_t size);
+void *HeadlessCalloc(size_t count, size_t size);
+void *HeadlessRealloc(void *ptr, size_t size);
+char *HeadlessStrdup(const char *str);
+void HeadlessFree(void *ptr);
+
+// Fixed timestep returned by GetFrameTime
+void SetHeadlessTimestep(float seconds);
+
+#define malloc(size) HeadlessMalloc(size)
+#define calloc(count, size) HeadlessCalloc(count, size)
+#define realloc(ptr, size) HeadlessRealloc(ptr, size)
+#define strdup(str) HeadlessStrdup(str)
+#define free(ptr) HeadlessFree(ptr)
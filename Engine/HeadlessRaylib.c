@@ -0,0 +1,368 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+// Stand-in for the parts of raylib used by the interpreter, so RapidEngineHeadless
+// runs without a window, GPU or audio device. Drawing, audio and input do nothing,
+// collision checks and text formatting behave like raylib.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "raylib.h"
+
+#define RAYMATH_IMPLEMENTATION
+#include "raymath.h"
+
+#include "Headless.h"
+
+#ifdef _WIN32
+int __stdcall QueryPerformanceCounter(long long *count);
+int __stdcall QueryPerformanceFrequency(long long *frequency);
+#else
+#include <time.h>
+#endif
+
+#define HEADLESS_TEXT_BUFFERS 4
+#define HEADLESS_TEXT_BUFFER_SIZE 1024
+
+#define HEADLESS_SOUND_SAMPLE_RATE 44100
+
+static float headlessTimestep = 1.0f / 60.0f;
+
+void SetHeadlessTimestep(float seconds)
+{
+    headlessTimestep = seconds;
+}
+
+float GetFrameTime(void)
+{
+    return headlessTimestep;
+}
+
+double GetTime(void)
+{
+#ifdef _WIN32
+    static long long frequency = 0;
+    if (frequency == 0)
+    {
+        QueryPerformanceFrequency(&frequency);
+    }
+    long long count;
+    QueryPerformanceCounter(&count);
+    return (double)count / frequency;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+#endif
+}
+
+int GetRandomValue(int min, int max)
+{
+    if (min > max)
+    {
+        int temp = max;
+        max = min;
+        min = temp;
+    }
+
+    return min + rand() % (max - min + 1);
+}
+
+const char *TextFormat(const char *text, ...)
+{
+    static char buffers[HEADLESS_TEXT_BUFFERS][HEADLESS_TEXT_BUFFER_SIZE];
+    static int index = 0;
+
+    char *buffer = buffers[index];
+    index = (index + 1) % HEADLESS_TEXT_BUFFERS;
+
+    va_list args;
+    va_start(args, text);
+    vsnprintf(buffer, HEADLESS_TEXT_BUFFER_SIZE, text, args);
+    va_end(args);
+
+    return buffer;
+}
+
+Vector2 MeasureTextEx(Font font, const char *text, float fontSize, float spacing)
+{
+    (void)font;
+    int length = (int)strlen(text);
+    return (Vector2){length * fontSize / 2 + (length > 0 ? (length - 1) * spacing : 0), fontSize};
+}
+
+// Only the size is read from PNG files, nothing is decoded or uploaded
+Image LoadImage(const char *fileName)
+{
+    FILE *file = fopen(fileName, "rb");
+    if (!file)
+    {
+        return (Image){0};
+    }
+
+    Image image = {.width = 1, .height = 1, .mipmaps = 1, .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+
+    unsigned char header[24];
+    if (fread(header, 1, sizeof(header), file) == sizeof(header) && memcmp(header, "\x89PNG", 4) == 0)
+    {
+        image.width = (header[16] << 24) | (header[17] << 16) | (header[18] << 8) | header[19];
+        image.height = (header[20] << 24) | (header[21] << 16) | (header[22] << 8) | header[23];
+    }
+
+    fclose(file);
+    return image;
+}
+
+void UnloadImage(Image image)
+{
+    (void)image;
+}
+
+Texture2D LoadTextureFromImage(Image image)
+{
+    if (image.width <= 0 || image.height <= 0)
+    {
+        return (Texture2D){0};
+    }
+    return (Texture2D){.id = 1, .width = image.width, .height = image.height, .mipmaps = 1, .format = image.format};
+}
+
+Texture2D LoadTexture(const char *fileName)
+{
+    return LoadTextureFromImage(LoadImage(fileName));
+}
+
+void UnloadTexture(Texture2D texture)
+{
+    (void)texture;
+}
+
+// Every sound that exists on disk plays for one second
+Wave LoadWave(const char *fileName)
+{
+    FILE *file = fopen(fileName, "rb");
+    if (!file)
+    {
+        return (Wave){0};
+    }
+    fclose(file);
+
+    return (Wave){.frameCount = HEADLESS_SOUND_SAMPLE_RATE, .sampleRate = HEADLESS_SOUND_SAMPLE_RATE, .sampleSize = 16, .channels = 1};
+}
+
+void UnloadWave(Wave wave)
+{
+    (void)wave;
+}
+
+Sound LoadSoundFromWave(Wave wave)
+{
+    Sound sound = {0};
+    sound.stream.sampleRate = wave.sampleRate;
+    sound.frameCount = wave.frameCount;
+    return sound;
+}
+
+Sound LoadSound(const char *fileName)
+{
+    return LoadSoundFromWave(LoadWave(fileName));
+}
+
+void UnloadSound(Sound sound)
+{
+    (void)sound;
+}
+
+Sound LoadSoundAlias(Sound source)
+{
+    return source;
+}
+
+void UnloadSoundAlias(Sound alias)
+{
+    (void)alias;
+}
+
+void PlaySound(Sound sound)
+{
+    (void)sound;
+}
+
+void SetSoundVolume(Sound sound, float volume)
+{
+    (void)sound;
+    (void)volume;
+}
+
+bool IsKeyPressed(int key)
+{
+    (void)key;
+    return false;
+}
+
+bool IsKeyReleased(int key)
+{
+    (void)key;
+    return false;
+}
+
+bool IsKeyDown(int key)
+{
+    (void)key;
+    return false;
+}
+
+bool IsKeyUp(int key)
+{
+    (void)key;
+    return true;
+}
+
+void ClearBackground(Color color)
+{
+    (void)color;
+}
+
+void DrawLine(int startPosX, int startPosY, int endPosX, int endPosY, Color color)
+{
+    (void)startPosX;
+    (void)startPosY;
+    (void)endPosX;
+    (void)endPosY;
+    (void)color;
+}
+
+void DrawLineV(Vector2 startPos, Vector2 endPos, Color color)
+{
+    (void)startPos;
+    (void)endPos;
+    (void)color;
+}
+
+void DrawCircle(int centerX, int centerY, float radius, Color color)
+{
+    (void)centerX;
+    (void)centerY;
+    (void)radius;
+    (void)color;
+}
+
+void DrawCircleLines(int centerX, int centerY, float radius, Color color)
+{
+    (void)centerX;
+    (void)centerY;
+    (void)radius;
+    (void)color;
+}
+
+void DrawRectangle(int posX, int posY, int width, int height, Color color)
+{
+    (void)posX;
+    (void)posY;
+    (void)width;
+    (void)height;
+    (void)color;
+}
+
+void DrawRectangleRec(Rectangle rec, Color color)
+{
+    (void)rec;
+    (void)color;
+}
+
+void DrawRectangleLinesEx(Rectangle rec, float lineThick, Color color)
+{
+    (void)rec;
+    (void)lineThick;
+    (void)color;
+}
+
+void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint)
+{
+    (void)texture;
+    (void)source;
+    (void)dest;
+    (void)origin;
+    (void)rotation;
+    (void)tint;
+}
+
+bool CheckCollisionRecs(Rectangle rec1, Rectangle rec2)
+{
+    return rec1.x < rec2.x + rec2.width && rec1.x + rec1.width > rec2.x &&
+           rec1.y < rec2.y + rec2.height && rec1.y + rec1.height > rec2.y;
+}
+
+bool CheckCollisionPointRec(Vector2 point, Rectangle rec)
+{
+    return point.x >= rec.x && point.x < rec.x + rec.width && point.y >= rec.y && point.y < rec.y + rec.height;
+}
+
+bool CheckCollisionPointCircle(Vector2 point, Vector2 center, float radius)
+{
+    float dx = point.x - center.x;
+    float dy = point.y - center.y;
+    return dx * dx + dy * dy <= radius * radius;
+}
+
+bool CheckCollisionPointPoly(Vector2 point, const Vector2 *points, int pointCount)
+{
+    bool inside = false;
+
+    if (pointCount < 3)
+    {
+        return false;
+    }
+
+    for (int i = 0, j = pointCount - 1; i < pointCount; j = i++)
+    {
+        if ((points[i].y > point.y) != (points[j].y > point.y) &&
+            point.x < (points[j].x - points[i].x) * (point.y - points[i].y) / (points[j].y - points[i].y) + points[i].x)
+        {
+            inside = !inside;
+        }
+    }
+
+    return inside;
+}
+
+bool CheckCollisionLines(Vector2 startPos1, Vector2 endPos1, Vector2 startPos2, Vector2 endPos2, Vector2 *collisionPoint)
+{
+    float div = (endPos2.y - startPos2.y) * (endPos1.x - startPos1.x) - (endPos2.x - startPos2.x) * (endPos1.y - startPos1.y);
+    if (fabsf(div) < FLT_EPSILON)
+    {
+        return false;
+    }
+
+    float t = ((endPos2.x - startPos2.x) * (startPos1.y - startPos2.y) - (endPos2.y - startPos2.y) * (startPos1.x - startPos2.x)) / div;
+    float u = ((endPos1.x - startPos1.x) * (startPos1.y - startPos2.y) - (endPos1.y - startPos1.y) * (startPos1.x - startPos2.x)) / div;
+    if (t < 0.0f || t > 1.0f || u < 0.0f || u > 1.0f)
+    {
+        return false;
+    }
+
+    if (collisionPoint)
+    {
+        *collisionPoint = (Vector2){startPos1.x + t * (endPos1.x - startPos1.x), startPos1.y + t * (endPos1.y - startPos1.y)};
+    }
+    return true;
+}
+
+bool CheckCollisionCircleLine(Vector2 center, float radius, Vector2 p1, Vector2 p2)
+{
+    float dx = p2.x - p1.x;
+    float dy = p2.y - p1.y;
+    float lengthSquared = dx * dx + dy * dy;
+
+    float t = 0.0f;
+    if (lengthSquared > 0.0f)
+    {
+        t = Clamp(((center.x - p1.x) * dx + (center.y - p1.y) * dy) / lengthSquared, 0.0f, 1.0f);
+    }
+
+    return CheckCollisionPointCircle((Vector2){p1.x + t * dx, p1.y + t * dy}, center, radius);
+}
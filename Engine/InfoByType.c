@@ -10,7 +10,7 @@ const char *subMenuItems[][subMenuItemCount] = {
     {"Get variable", "Get Screen Width", "Get Screen Height", "Get Mouse Position", "Get Random Number", "Get Sprite Position"},
     {"Set variable", "Set Background", "Set FPS"},
     {"Branch", "Loop", "Flip Flop", "Break", "Sequence"},
-    {"Create sprite", "Spawn sprite", "Destroy sprite", "Set Sprite Position", "Set Sprite Rotation", "Set Sprite Texture", "Set Sprite Size", "Force"},
+    {"Create sprite", "Spawn sprite", "Spawn sprite instance", "Destroy sprite", "Set Sprite Position", "Set Sprite Rotation", "Set Sprite Texture", "Set Sprite Size", "Force"},
     {"Draw Prop Rectangle", "Draw Prop Circle"},
     {"Comparison", "Gate", "Arithmetic", "Clamp", "Lerp", "Sin", "Cos"},
     {"Print To Log", "Draw Debug Line", "Comment"},
@@ -18,4 +18,4 @@ const char *subMenuItems[][subMenuItemCount] = {
     {"Move Camera", "Zoom Camera", "Get Camera Center", "Shake Camera"},
     {"Play Sound"}};
 
-const int subMenuCounts[] = {8, 3, 6, 3, 5, 8, 2, 7, 3, 4, 4, 1};
\ No newline at end of file
+const int subMenuCounts[] = {8, 3, 6, 3, 5, 9, 2, 7, 3, 4, 4, 1};
\ No newline at end of file
@@ -57,6 +57,7 @@ typedef enum
     NODE_SET_SPRITE_SIZE = 606,
     NODE_MOVE_TO_SPRITE = 607,
     NODE_FORCE_SPRITE = 608,
+    NODE_SPAWN_SPRITE_INSTANCE = 609,
 
     NODE_DRAW_PROP_TEXTURE = 700,
     NODE_DRAW_PROP_RECTANGLE = 701,
@@ -213,6 +214,7 @@ static InfoByType NodeInfoByType[] = {
     {NODE_SET_SPRITE_SIZE, 4, 1, 170, 160, {40, 110, 70, 200}, false, {PIN_FLOW, PIN_SPRITE_VARIABLE, PIN_NUM, PIN_NUM}, {PIN_FLOW}, {"Prev", "Sprite", "Width", "Height"}, {"Next"}},
     {NODE_MOVE_TO_SPRITE, 0, 0, 260, 36, {0, 0, 0, 255}, false, {0}, {0}, {0}, {0}}, // not implemented
     {NODE_FORCE_SPRITE, 5, 1, 160, 190, {40, 110, 70, 200}, false, {PIN_FLOW, PIN_SPRITE_VARIABLE, PIN_NUM, PIN_NUM, PIN_NUM}, {PIN_FLOW}, {"Prev", "Sprite", "Pixels / second", "Angle", "Time"}, {"Next"}},
+    {NODE_SPAWN_SPRITE_INSTANCE, 5, 1, 150, 190, {40, 110, 70, 200}, false, {PIN_FLOW, PIN_SPRITE_VARIABLE, PIN_NUM, PIN_NUM, PIN_NUM}, {PIN_FLOW}, {"Prev", "Sprite", "Pos X", "Pos Y", "Rotation"}, {"Next"}},
 
     {NODE_DRAW_PROP_TEXTURE, 0, 0, 260, 36, {0, 0, 0, 255}, false, {0}, {0}, {0}, {0}},                                                                                                                                                              // not implemented
     {NODE_DRAW_PROP_RECTANGLE, 7, 2, 230, 260, {40, 110, 70, 200}, false, {PIN_FLOW, PIN_NUM, PIN_NUM, PIN_NUM, PIN_NUM, PIN_COLOR, PIN_DROPDOWN_LAYER}, {PIN_FLOW, PIN_NONE}, {"Prev", "Pos X", "Pos Y", "Width", "Height", "Color", "Layer"}, {"Next"}},
@@ -512,6 +514,8 @@ static inline const char *NodeTypeToString(NodeType type)
         return "Move To";
     case NODE_FORCE_SPRITE:
         return "Force";
+    case NODE_SPAWN_SPRITE_INSTANCE:
+        return "Spawn instance";
 
     case NODE_DRAW_PROP_TEXTURE:
         return "Prop Texture";
@@ -730,6 +734,10 @@ static inline NodeType StringToNodeType(const char strType[])
     {
         return NODE_FORCE_SPRITE;
     }
+    if (strcmp(strType, "Spawn sprite instance") == 0)
+    {
+        return NODE_SPAWN_SPRITE_INSTANCE;
+    }
 
     if (strcmp(strType, "Draw Prop Texture") == 0)
     {
@@ -3,8 +3,7 @@
 
 #include "Interpreter.h"
 #include "raymath.h"
-
-#define MAX_FORCES 100
+#include <limits.h>
 
 InterpreterContext InitInterpreterContext()
 {
@@ -14,9 +13,7 @@ InterpreterContext InitInterpreterContext()
     intp.varCount = 0;
     intp.onButtonNodeIndexesCount = 0;
     intp.componentCount = 0;
-    intp.forceCount = 0;
     intp.tickNodeIndexesCount = 0;
-    intp.soundCount = 0;
 
     intp.isFirstFrame = true;
 
@@ -43,12 +40,29 @@ InterpreterContext InitInterpreterContext()
 
     intp.shouldBreakFromLoop = false;
 
+    intp.continuations = NULL;
+    intp.continuationCount = 0;
+    intp.continuationCapacity = 0;
+
     intp.isSoundOn = true;
     intp.hasSoundOnChanged = true;
+    intp.sounds.volume = 1.0f;
+
+    intp.isBytecodeVMOn = true;
+
+    intp.isFixedTimestepOn = false;
+    intp.tickAccumulator = 0.0f;
+    intp.deltaTime = 0.0f;
+    intp.interpolationAlpha = 1.0f;
+
+    intp.stepDebugLines = (DebugLineList){0};
+    intp.frameDebugLines = (DebugLineList){0};
+    intp.isRunningStep = false;
 
     return intp;
 }
 
+// Nodes, pins and their field text are in the interpreter arena and released with it
 void FreeRuntimeGraphContext(RuntimeGraphContext *rg)
 {
     if (!rg)
@@ -56,25 +70,8 @@ void FreeRuntimeGraphContext(RuntimeGraphContext *rg)
         return;
     }
 
-    if (rg->nodes)
-    {
-        free(rg->nodes);
-        rg->nodes = NULL;
-    }
-
-    if (rg->pins)
-    {
-        for (int i = 0; i < rg->pinCount; i++)
-        {
-            if (rg->pins[i].textFieldValue)
-            {
-                free(rg->pins[i].textFieldValue);
-            }
-        }
-        free(rg->pins);
-        rg->pins = NULL;
-    }
-
+    rg->nodes = NULL;
+    rg->pins = NULL;
     rg->nodeCount = 0;
     rg->pinCount = 0;
 }
@@ -84,49 +81,46 @@ void FreeInterpreterContext(InterpreterContext *intp)
     if (!intp)
         return;
 
-    if (intp->values)
+    FreeSoundBank(&intp->sounds);
+
+    if (intp->runtimeGraph)
     {
-        for (int i = 0; i < intp->valueCount; i++)
-        {
-            if (intp->values[i].type == VAL_STRING && intp->values[i].string)
-            {
-                free((void *)intp->values[i].string);
-            }
-        }
-        free(intp->values);
+        FreeRuntimeGraphContext(intp->runtimeGraph);
     }
 
-    free(intp->onButtonNodeIndexes);
+    FreeBytecodeProgram(&intp->bytecode);
 
-    free(intp->forces);
+    free(intp->continuations);
 
-    if (intp->components)
-    {
-        for (int i = 0; i < intp->componentCount; i++)
-        {
-            if (intp->components[i].isSprite && intp->components[i].sprite.texture.id)
-            {
-                UnloadTexture(intp->components[i].sprite.texture);
-            }
-        }
-        free(intp->components);
-    }
+    free(intp->stepDebugLines.lines);
+    free(intp->frameDebugLines.lines);
 
-    free(intp->varIndexes);
+    FreeCollisionGrid(&intp->collisionGrid);
 
-    for (int i = 0; i < intp->soundCount; i++)
-    {
-        UnloadSound(intp->sounds[i].sound);
-    }
+    FreeForceStore(&intp->forces);
 
-    if (intp->runtimeGraph)
-    {
-        FreeRuntimeGraphContext(intp->runtimeGraph);
-    }
+    FreeStringTable(&intp->strings);
+
+    FreeTextureCache(&intp->textures);
+
+    // Values, their strings, components, forces and the runtime graph all go at once
+    ResetArena(&intp->arena);
 
     char *projectPath = intp->projectPath;
+    bool isBytecodeVMOn = intp->isBytecodeVMOn;
+    bool isFixedTimestepOn = intp->isFixedTimestepOn;
+#ifdef RAPID_PROFILER
+    bool isProfilerOn = intp->profiler.isOn;
+#endif
+    Arena arena = intp->arena;
     *intp = InitInterpreterContext();
     intp->projectPath = projectPath;
+    intp->isBytecodeVMOn = isBytecodeVMOn;
+    intp->isFixedTimestepOn = isFixedTimestepOn;
+#ifdef RAPID_PROFILER
+    intp->profiler.isOn = isProfilerOn;
+#endif
+    intp->arena = arena;
 }
 
 char *ValueTypeToString(ValueType type)
@@ -150,7 +144,51 @@ char *ValueTypeToString(ValueType type)
     }
 }
 
-char *ValueToString(Value value)
+static int InternValueString(InterpreterContext *intp, const char *text)
+{
+    return InternString(&intp->strings, &intp->arena, text);
+}
+
+const char *GetValueString(InterpreterContext *intp, Value value)
+{
+    return GetInternedString(&intp->strings, value.stringID);
+}
+
+// Component of the sprite value at valueIndex, -1 if it is not a sprite or not bound to one
+static int GetSpriteComponentIndex(InterpreterContext *intp, int valueIndex)
+{
+    if (valueIndex < 0 || valueIndex >= intp->valueCount || intp->values[valueIndex].type != VAL_SPRITE)
+    {
+        return -1;
+    }
+
+    int componentIndex = intp->values[valueIndex].componentIndex;
+    if (componentIndex < 0 || componentIndex >= intp->componentCount || !intp->components[componentIndex].isSprite || intp->components[componentIndex].isFree)
+    {
+        return -1;
+    }
+    return componentIndex;
+}
+
+// Moved sprites are otherwise drawn sliding from where they were before the current fixed step
+static void SnapSpriteInterpolation(InterpreterContext *intp, int componentIndex)
+{
+    intp->previousPositions[componentIndex] = intp->components[componentIndex].sprite.position;
+}
+
+// Sprite values are views onto their component, so this is always the live state
+static const SceneComponent *GetValueComponent(InterpreterContext *intp, Value value)
+{
+    static const SceneComponent unboundComponent = {0};
+
+    if (value.type != VAL_SPRITE || value.componentIndex < 0 || value.componentIndex >= intp->componentCount)
+    {
+        return &unboundComponent;
+    }
+    return &intp->components[value.componentIndex];
+}
+
+char *ValueToString(InterpreterContext *intp, Value value)
 {
     static char temp[MAX_LOG_MESSAGE_SIZE];
     switch (value.type)
@@ -162,7 +200,7 @@ char *ValueToString(Value value)
         strmac(temp, MAX_LOG_MESSAGE_SIZE, "%.2f", value.number);
         break;
     case VAL_STRING:
-        strmac(temp, MAX_LOG_MESSAGE_SIZE, "%s", value.string);
+        strmac(temp, MAX_LOG_MESSAGE_SIZE, "%s", GetValueString(intp, value));
         break;
     case VAL_BOOL:
         strmac(temp, MAX_LOG_MESSAGE_SIZE, "%s", value.boolean ? "true" : "false");
@@ -171,22 +209,25 @@ char *ValueToString(Value value)
         strmac(temp, MAX_LOG_MESSAGE_SIZE, "R:%d G:%d B:%d A:%d", value.color.r, value.color.g, value.color.b, value.color.a);
         break;
     case VAL_SPRITE:
-        strmac(temp, MAX_LOG_MESSAGE_SIZE, "%s, PosX: %.0f, PosY: %.0f, Rotation: %.2f", value.sprite.isVisible ? "Visible" : "Not visible", value.sprite.position.x, value.sprite.position.y, value.sprite.rotation);
+    {
+        const SceneComponent *component = GetValueComponent(intp, value);
+        strmac(temp, MAX_LOG_MESSAGE_SIZE, "%s, PosX: %.0f, PosY: %.0f, Rotation: %.2f", component->isVisible ? "Visible" : "Not visible", component->sprite.position.x, component->sprite.position.y, component->sprite.rotation);
         break;
+    }
     default:
         strmac(temp, MAX_LOG_MESSAGE_SIZE, "Error");
     }
     return temp;
 }
 
-void AddToLogFromInterpreter(InterpreterContext *intp, Value message, int level)
+void AddToLogFromInterpreter(InterpreterContext *intp, const char *message, int level)
 {
     if (intp->logMessageCount >= MAX_LOG_MESSAGES)
     {
         return;
     }
 
-    strmac(intp->logMessages[intp->logMessageCount], MAX_LOG_MESSAGE_SIZE, "%s", ValueToString(message));
+    strmac(intp->logMessages[intp->logMessageCount], MAX_LOG_MESSAGE_SIZE, "%s", message);
     intp->logMessageLevels[intp->logMessageCount] = level;
     intp->logMessageCount++;
     intp->newLogMessage = true;
@@ -202,31 +243,385 @@ void UpdateSpecialValues(InterpreterContext *intp, Vector2 mousePos, Rectangle s
     intp->values[SPECIAL_VALUE_CAMERA_CENTER_Y].number = screenBoundary.y + screenBoundary.height / 2;
 }
 
+static unsigned int HashForceKey(int nodeIndex, int componentIndex, int slotCapacity)
+{
+    return ((unsigned int)nodeIndex * 2654435761u ^ (unsigned int)componentIndex * 2246822519u) & (unsigned int)(slotCapacity - 1);
+}
+
+// Force started by nodeIndex on componentIndex, -1 if there is none
+static int FindForce(const ForceStore *forces, int nodeIndex, int componentIndex)
+{
+    if (forces->slotCapacity == 0)
+    {
+        return -1;
+    }
+
+    unsigned int slot = HashForceKey(nodeIndex, componentIndex, forces->slotCapacity);
+    while (forces->slots[slot] != -1)
+    {
+        int i = forces->slots[slot];
+        if (forces->nodeIndexes[i] == nodeIndex && forces->componentIndexes[i] == componentIndex)
+        {
+            return i;
+        }
+        slot = (slot + 1) & (forces->slotCapacity - 1);
+    }
+    return -1;
+}
+
+static unsigned int FindForceSlot(const ForceStore *forces, int index)
+{
+    unsigned int slot = HashForceKey(forces->nodeIndexes[index], forces->componentIndexes[index], forces->slotCapacity);
+    while (forces->slots[slot] != index)
+    {
+        slot = (slot + 1) & (forces->slotCapacity - 1);
+    }
+    return slot;
+}
+
+static bool ResizeForceSlots(ForceStore *forces, int newSlotCapacity)
+{
+    int *newSlots = malloc(sizeof(int) * newSlotCapacity);
+    if (!newSlots)
+    {
+        return false;
+    }
+    memset(newSlots, -1, sizeof(int) * newSlotCapacity);
+
+    for (int i = 0; i < forces->count; i++)
+    {
+        unsigned int slot = HashForceKey(forces->nodeIndexes[i], forces->componentIndexes[i], newSlotCapacity);
+        while (newSlots[slot] != -1)
+        {
+            slot = (slot + 1) & (newSlotCapacity - 1);
+        }
+        newSlots[slot] = i;
+    }
+
+    free(forces->slots);
+    forces->slots = newSlots;
+    forces->slotCapacity = newSlotCapacity;
+    return true;
+}
+
+static bool GrowForceStore(ForceStore *forces)
+{
+    int newCapacity = forces->capacity ? forces->capacity * 2 : FORCE_STORE_INITIAL_CAPACITY;
+
+    // Every array that grew is kept even if a later one fails, the capacity only changes once all have
+    int *nodeIndexes = realloc(forces->nodeIndexes, sizeof(int) * newCapacity);
+    if (!nodeIndexes)
+        return false;
+    forces->nodeIndexes = nodeIndexes;
+
+    int *componentIndexes = realloc(forces->componentIndexes, sizeof(int) * newCapacity);
+    if (!componentIndexes)
+        return false;
+    forces->componentIndexes = componentIndexes;
+
+    int *generations = realloc(forces->generations, sizeof(int) * newCapacity);
+    if (!generations)
+        return false;
+    forces->generations = generations;
+
+    float *velocitiesX = realloc(forces->velocitiesX, sizeof(float) * newCapacity);
+    if (!velocitiesX)
+        return false;
+    forces->velocitiesX = velocitiesX;
+
+    float *velocitiesY = realloc(forces->velocitiesY, sizeof(float) * newCapacity);
+    if (!velocitiesY)
+        return false;
+    forces->velocitiesY = velocitiesY;
+
+    float *durations = realloc(forces->durations, sizeof(float) * newCapacity);
+    if (!durations)
+        return false;
+    forces->durations = durations;
+
+    // Kept at most half full so probes stay short
+    if (newCapacity * 2 > forces->slotCapacity && !ResizeForceSlots(forces, newCapacity * 2))
+        return false;
+
+    forces->capacity = newCapacity;
+    return true;
+}
+
+static void SetForce(ForceStore *forces, int index, int generation, int pixelsPerSecond, int angle, float duration)
+{
+    float radians = angle * (PI / 180.0f);
+
+    forces->generations[index] = generation;
+    forces->velocitiesX[index] = cosf(radians) * pixelsPerSecond;
+    forces->velocitiesY[index] = -sinf(radians) * pixelsPerSecond;
+    forces->durations[index] = duration;
+}
+
+static bool AddForce(ForceStore *forces, int nodeIndex, int componentIndex, int generation, int pixelsPerSecond, int angle, float duration)
+{
+    if (forces->count >= forces->capacity && !GrowForceStore(forces))
+    {
+        return false;
+    }
+
+    int i = forces->count++;
+    forces->nodeIndexes[i] = nodeIndex;
+    forces->componentIndexes[i] = componentIndex;
+    SetForce(forces, i, generation, pixelsPerSecond, angle, duration);
+
+    unsigned int slot = HashForceKey(nodeIndex, componentIndex, forces->slotCapacity);
+    while (forces->slots[slot] != -1)
+    {
+        slot = (slot + 1) & (forces->slotCapacity - 1);
+    }
+    forces->slots[slot] = i;
+
+    return true;
+}
+
+static void RemoveForce(ForceStore *forces, int index)
+{
+    // Later forces in the same probe run are shifted back so lookups still reach them
+    unsigned int mask = forces->slotCapacity - 1;
+    unsigned int hole = FindForceSlot(forces, index);
+    unsigned int slot = (hole + 1) & mask;
+    while (forces->slots[slot] != -1)
+    {
+        int i = forces->slots[slot];
+        unsigned int home = HashForceKey(forces->nodeIndexes[i], forces->componentIndexes[i], forces->slotCapacity);
+        if (((slot - home) & mask) >= ((slot - hole) & mask))
+        {
+            forces->slots[hole] = i;
+            hole = slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    forces->slots[hole] = -1;
+
+    int last = --forces->count;
+    if (index == last)
+    {
+        return;
+    }
+
+    forces->slots[FindForceSlot(forces, last)] = index;
+    forces->nodeIndexes[index] = forces->nodeIndexes[last];
+    forces->componentIndexes[index] = forces->componentIndexes[last];
+    forces->generations[index] = forces->generations[last];
+    forces->velocitiesX[index] = forces->velocitiesX[last];
+    forces->velocitiesY[index] = forces->velocitiesY[last];
+    forces->durations[index] = forces->durations[last];
+}
+
+void FreeForceStore(ForceStore *forces)
+{
+    free(forces->nodeIndexes);
+    free(forces->componentIndexes);
+    free(forces->generations);
+    free(forces->velocitiesX);
+    free(forces->velocitiesY);
+    free(forces->durations);
+    free(forces->slots);
+
+    *forces = (ForceStore){0};
+}
+
+// Decodes the files that sprites, texture swaps and sounds start with on worker threads, then uploads them here
+// so the first use of each one is a cache hit. Anything that fails is left to be loaded, and reported, on first use
+static void PreloadGraphAssets(InterpreterContext *intp, RuntimeGraphContext *runtime)
+{
+    int maxAssets = 0;
+    for (int i = 0; i < runtime->nodeCount; i++)
+    {
+        NodeType type = runtime->nodes[i].type;
+        if (type == NODE_CREATE_SPRITE || type == NODE_SET_SPRITE_TEXTURE || type == NODE_PLAY_SOUND)
+        {
+            maxAssets++;
+        }
+    }
+    if (maxAssets == 0)
+    {
+        return;
+    }
+
+    AssetPreload *assets = ArenaCalloc(&intp->arena, maxAssets, sizeof(AssetPreload));
+    int *stringIDs = ArenaCalloc(&intp->arena, maxAssets, sizeof(int));
+    if (!assets || !stringIDs)
+    {
+        return;
+    }
+
+    int assetCount = 0;
+    for (int i = 0; i < runtime->nodeCount; i++)
+    {
+        RuntimeNode *node = &runtime->nodes[i];
+
+        RuntimePin *pathPin;
+        AssetKind kind;
+        switch (node->type)
+        {
+        case NODE_CREATE_SPRITE:
+            pathPin = node->inputPins[1];
+            kind = ASSET_IMAGE;
+            break;
+        case NODE_SET_SPRITE_TEXTURE:
+            pathPin = node->inputPins[2];
+            kind = ASSET_IMAGE;
+            break;
+        case NODE_PLAY_SOUND:
+            pathPin = node->inputPins[1];
+            kind = ASSET_WAVE;
+            break;
+        default:
+            continue;
+        }
+
+        if (!pathPin || pathPin->valueIndex < 0 || pathPin->valueIndex >= intp->valueCount || intp->values[pathPin->valueIndex].type != VAL_STRING)
+        {
+            continue;
+        }
+
+        // Equal file names have equal string IDs
+        int stringID = intp->values[pathPin->valueIndex].stringID;
+        if (stringID == STRING_ID_EMPTY)
+        {
+            continue;
+        }
+        bool isDuplicate = false;
+        for (int j = 0; j < assetCount && !isDuplicate; j++)
+        {
+            isDuplicate = stringIDs[j] == stringID && assets[j].kind == kind;
+        }
+        if (isDuplicate)
+        {
+            continue;
+        }
+
+        stringIDs[assetCount] = stringID;
+        assets[assetCount].kind = kind;
+        assets[assetCount].path = ArenaFormat(&intp->arena, MAX_FILE_PATH, "%s%c%s", intp->projectPath, PATH_SEPARATOR, GetInternedString(&intp->strings, stringID));
+        assetCount++;
+    }
+    if (assetCount == 0)
+    {
+        return;
+    }
+
+    AddToLogFromInterpreter(intp, TextFormat("Preloading %d assets{I301}", assetCount), LOG_LEVEL_NORMAL);
+    double startTime = GetTime();
+
+    int threadCount = DecodeAssets(assets, assetCount);
+
+    int loadedCount = 0;
+    for (int i = 0; i < assetCount; i++)
+    {
+        if (!assets[i].isDecoded)
+        {
+            continue;
+        }
+
+        switch (assets[i].kind)
+        {
+        case ASSET_IMAGE:
+            loadedCount += PreloadTexture(&intp->textures, &intp->arena, assets[i].path, assets[i].image);
+            UnloadImage(assets[i].image);
+            break;
+        case ASSET_WAVE:
+            loadedCount += PreloadSound(&intp->sounds, &intp->arena, assets[i].path, assets[i].wave);
+            UnloadWave(assets[i].wave);
+            break;
+        }
+    }
+
+    AddToLogFromInterpreter(intp, TextFormat("Preloaded %d of %d assets on %d threads in %.0f ms{I302}", loadedCount, assetCount, threadCount, (GetTime() - startTime) * 1000), LOG_LEVEL_NORMAL);
+}
+
+// Create node of each entry in graph->variables, -1 for names no node has. Lets Get and Set Variable bind
+// without comparing their variable name against every node
+static int *MapVariablesToNodes(GraphContext *graph, Arena *arena)
+{
+    int *nodeIndexByVariable = ArenaAlloc(arena, sizeof(int) * (graph->variablesCount + 1));
+    if (!nodeIndexByVariable)
+    {
+        return NULL;
+    }
+
+    HashIndex nodeIndexByName = {0};
+    for (int i = 0; i < graph->nodeCount; i++)
+    {
+        NodeType type = graph->nodes[i].type;
+        if (type != NODE_CREATE_NUMBER && type != NODE_CREATE_STRING && type != NODE_CREATE_BOOL && type != NODE_CREATE_COLOR && type != NODE_CREATE_SPRITE)
+        {
+            continue;
+        }
+
+        const char *name = graph->nodes[i].name;
+        int length = (int)strlen(name);
+        unsigned int hash = HashBytes(name, length);
+        if (FindInHashIndex(&nodeIndexByName, name, length, hash) != HASH_INDEX_NONE)
+        {
+            continue;
+        }
+        if (!ReserveHashIndex(&nodeIndexByName))
+        {
+            FreeHashIndex(&nodeIndexByName);
+            return NULL;
+        }
+        InsertIntoHashIndex(&nodeIndexByName, name, length, hash, i);
+    }
+
+    for (int i = 0; i < graph->variablesCount; i++)
+    {
+        const char *name = graph->variables[i];
+        int length = (int)strlen(name);
+        nodeIndexByVariable[i] = FindInHashIndex(&nodeIndexByName, name, length, HashBytes(name, length));
+    }
+
+    FreeHashIndex(&nodeIndexByName);
+    return nodeIndexByVariable;
+}
+
+static int GetVariableNodeIndex(GraphContext *graph, const int *nodeIndexByVariable, const RuntimePin *variablePin)
+{
+    if (!variablePin || variablePin->pickedOption < 0 || variablePin->pickedOption >= graph->variablesCount)
+    {
+        return -1;
+    }
+    return nodeIndexByVariable[variablePin->pickedOption];
+}
+
 RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContext *intp)
 {
     RuntimeGraphContext runtime = {0};
 
+    if (!VerifyMappedArrays(graph))
+    {
+        intp->buildFailed = true;
+        intp->buildErrorOccured = true;
+        AddToLogFromInterpreter(intp, "Graph file is damaged{I221}", LOG_LEVEL_ERROR);
+        return runtime;
+    }
+
     runtime.nodeCount = graph->nodeCount;
-    runtime.nodes = malloc(sizeof(RuntimeNode) * graph->nodeCount);
+    runtime.nodes = ArenaAlloc(&intp->arena, sizeof(RuntimeNode) * graph->nodeCount);
 
     if (!runtime.nodes)
     {
         intp->buildFailed = true;
         intp->buildErrorOccured = true;
-        AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Out of memory: nodes{I200}"}, LOG_LEVEL_ERROR);
+        AddToLogFromInterpreter(intp, "Out of memory: nodes{I200}", LOG_LEVEL_ERROR);
         return runtime;
     }
 
     runtime.pinCount = graph->pinCount;
-    runtime.pins = malloc(sizeof(RuntimePin) * graph->pinCount);
+    runtime.pins = ArenaAlloc(&intp->arena, sizeof(RuntimePin) * graph->pinCount);
 
     if (!runtime.pins)
     {
-        free(runtime.nodes);
         runtime.nodes = NULL;
         intp->buildFailed = true;
         intp->buildErrorOccured = true;
-        AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Out of memory: pins{I201}"}, LOG_LEVEL_ERROR);
+        AddToLogFromInterpreter(intp, "Out of memory: pins{I201}", LOG_LEVEL_ERROR);
         return runtime;
     }
 
@@ -243,7 +638,7 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
         dst->pickedOption = src->pickedOption;
         dst->nextNodeIndex = -1;
         dst->componentIndex = -1;
-        dst->textFieldValue = strmac(NULL, MAX_LITERAL_NODE_FIELD_SIZE - 1, "%s", src->textFieldValue);
+        dst->textFieldValue = ArenaFormat(&intp->arena, MAX_LITERAL_NODE_FIELD_SIZE - 1, "%s", src->textFieldValue);
     }
 
     for (int i = 0; i < graph->nodeCount; i++)
@@ -263,21 +658,13 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
 
         for (int j = 0; j < srcNode->inputCount; j++)
         {
-            int pinIndex = -1;
-            for (int k = 0; k < graph->pinCount; k++)
-            {
-                if (graph->pins[k].id == srcNode->inputPins[j])
-                {
-                    pinIndex = k;
-                    break;
-                }
-            }
+            int pinIndex = FindPinIndexByID(graph, srcNode->inputPins[j]);
             if (pinIndex < 0)
             {
                 dstNode->inputPins[j] = NULL;
                 intp->buildFailed = true;
                 intp->buildErrorOccured = true;
-                AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Input pin mapping failed{I202}"}, LOG_LEVEL_ERROR);
+                AddToLogFromInterpreter(intp, "Input pin mapping failed{I202}", LOG_LEVEL_ERROR);
                 return runtime;
             }
             dstNode->inputPins[j] = &runtime.pins[pinIndex];
@@ -286,21 +673,13 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
 
         for (int j = 0; j < srcNode->outputCount; j++)
         {
-            int pinIndex = -1;
-            for (int k = 0; k < graph->pinCount; k++)
-            {
-                if (graph->pins[k].id == srcNode->outputPins[j])
-                {
-                    pinIndex = k;
-                    break;
-                }
-            }
+            int pinIndex = FindPinIndexByID(graph, srcNode->outputPins[j]);
             if (pinIndex < 0)
             {
                 dstNode->outputPins[j] = NULL;
                 intp->buildFailed = true;
                 intp->buildErrorOccured = true;
-                AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Output pin mapping failed{I203}"}, LOG_LEVEL_ERROR);
+                AddToLogFromInterpreter(intp, "Output pin mapping failed{I203}", LOG_LEVEL_ERROR);
                 return runtime;
             }
             dstNode->outputPins[j] = &runtime.pins[pinIndex];
@@ -308,6 +687,20 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
         }
     }
 
+#ifdef RAPID_PROFILER
+    if (!StartProfiler(&intp->profiler, &intp->arena, graph->nodeCount))
+    {
+        intp->buildFailed = true;
+        intp->buildErrorOccured = true;
+        AddToLogFromInterpreter(intp, "Out of memory: profiler{I220}", LOG_LEVEL_ERROR);
+        return runtime;
+    }
+    for (int i = 0; i < graph->nodeCount; i++)
+    {
+        intp->profiler.nodeTypes[i] = runtime.nodes[i].type;
+    }
+#endif
+
     int totalOutputPins = 0;
     int totalComponents = 0;
     for (int i = 0; i < graph->nodeCount; i++)
@@ -332,53 +725,105 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
     }
 
     int expectedValues = totalOutputPins + SPECIAL_VALUES_COUNT;
-    intp->values = calloc(expectedValues, sizeof(Value));
+    intp->values = ArenaCalloc(&intp->arena, expectedValues, sizeof(Value));
     if (!intp->values)
     {
         intp->buildFailed = true;
         intp->buildErrorOccured = true;
-        AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Out of memory: values{I204}"}, LOG_LEVEL_ERROR);
+        AddToLogFromInterpreter(intp, "Out of memory: values{I204}", LOG_LEVEL_ERROR);
         return runtime;
     }
 
-    intp->values[SPECIAL_VALUE_ERROR] = (Value){.type = VAL_STRING, .string = strmac(NULL, 12, "Error value"), .name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, "Error value")};
-    intp->values[SPECIAL_VALUE_MOUSE_X] = (Value){.type = VAL_NUMBER, .number = 0, .name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, "Mouse X")};
-    intp->values[SPECIAL_VALUE_MOUSE_Y] = (Value){.type = VAL_NUMBER, .number = 0, .name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, "Mouse Y")};
-    intp->values[SPECIAL_VALUE_SCREEN_WIDTH] = (Value){.type = VAL_NUMBER, .number = 0, .name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, "Screen Width")};
-    intp->values[SPECIAL_VALUE_SCREEN_HEIGHT] = (Value){.type = VAL_NUMBER, .number = 0, .name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, "Screen Height")};
-    intp->values[SPECIAL_VALUE_CAMERA_CENTER_X] = (Value){.type = VAL_NUMBER, .number = 0, .name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, "Screen Center X")};
-    intp->values[SPECIAL_VALUE_CAMERA_CENTER_Y] = (Value){.type = VAL_NUMBER, .number = 0, .name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, "Screen Center Y")};
-    intp->valueCount = SPECIAL_VALUES_COUNT;
+    intp->valueNames = ArenaCalloc(&intp->arena, expectedValues, sizeof(char *));
+    if (!intp->valueNames)
+    {
+        intp->buildFailed = true;
+        intp->buildErrorOccured = true;
+        AddToLogFromInterpreter(intp, "Out of memory: values{I204}", LOG_LEVEL_ERROR);
+        return runtime;
+    }
+
+    intp->values[SPECIAL_VALUE_ERROR] = (Value){.type = VAL_STRING, .stringID = InternValueString(intp, "Error value")};
+    intp->values[SPECIAL_VALUE_MOUSE_X] = (Value){.type = VAL_NUMBER, .number = 0};
+    intp->values[SPECIAL_VALUE_MOUSE_Y] = (Value){.type = VAL_NUMBER, .number = 0};
+    intp->values[SPECIAL_VALUE_SCREEN_WIDTH] = (Value){.type = VAL_NUMBER, .number = 0};
+    intp->values[SPECIAL_VALUE_SCREEN_HEIGHT] = (Value){.type = VAL_NUMBER, .number = 0};
+    intp->values[SPECIAL_VALUE_CAMERA_CENTER_X] = (Value){.type = VAL_NUMBER, .number = 0};
+    intp->values[SPECIAL_VALUE_CAMERA_CENTER_Y] = (Value){.type = VAL_NUMBER, .number = 0};
+    intp->valueNames[SPECIAL_VALUE_ERROR] = "Error value";
+    intp->valueNames[SPECIAL_VALUE_MOUSE_X] = "Mouse X";
+    intp->valueNames[SPECIAL_VALUE_MOUSE_Y] = "Mouse Y";
+    intp->valueNames[SPECIAL_VALUE_SCREEN_WIDTH] = "Screen Width";
+    intp->valueNames[SPECIAL_VALUE_SCREEN_HEIGHT] = "Screen Height";
+    intp->valueNames[SPECIAL_VALUE_CAMERA_CENTER_X] = "Screen Center X";
+    intp->valueNames[SPECIAL_VALUE_CAMERA_CENTER_Y] = "Screen Center Y";
+    intp->valueCount = SPECIAL_VALUES_COUNT;
 
-    intp->components = calloc(totalComponents + 1, sizeof(SceneComponent));
+    intp->components = ArenaCalloc(&intp->arena, totalComponents + 1, sizeof(SceneComponent));
     if (!intp->components)
     {
         intp->buildFailed = true;
         intp->buildErrorOccured = true;
-        AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Out of memory: components{I205}"}, LOG_LEVEL_ERROR);
+        AddToLogFromInterpreter(intp, "Out of memory: components{I205}", LOG_LEVEL_ERROR);
         return runtime;
     }
     intp->componentCount = 0;
 
-    intp->varIndexes = malloc(sizeof(int) * (totalOutputPins + 1));
+    intp->worldHitboxes = ArenaCalloc(&intp->arena, totalComponents + 1, sizeof(WorldHitbox));
+    if (!intp->worldHitboxes)
+    {
+        intp->buildFailed = true;
+        intp->buildErrorOccured = true;
+        AddToLogFromInterpreter(intp, "Out of memory: hitboxes{I215}", LOG_LEVEL_ERROR);
+        return runtime;
+    }
+
+    intp->renderQueue = ArenaAlloc(&intp->arena, sizeof(RenderItem) * (totalComponents + 1));
+    if (!intp->renderQueue)
+    {
+        intp->buildFailed = true;
+        intp->buildErrorOccured = true;
+        AddToLogFromInterpreter(intp, "Out of memory: render queue{I217}", LOG_LEVEL_ERROR);
+        return runtime;
+    }
+
+    intp->previousPositions = ArenaCalloc(&intp->arena, totalComponents + 1, sizeof(Vector2));
+    if (!intp->previousPositions)
+    {
+        intp->buildFailed = true;
+        intp->buildErrorOccured = true;
+        AddToLogFromInterpreter(intp, "Out of memory: positions{I218}", LOG_LEVEL_ERROR);
+        return runtime;
+    }
+
+    intp->freeComponents = ArenaAlloc(&intp->arena, sizeof(int) * (totalComponents + 1));
+    if (!intp->freeComponents)
+    {
+        intp->buildFailed = true;
+        intp->buildErrorOccured = true;
+        AddToLogFromInterpreter(intp, "Out of memory: sprite pool{I219}", LOG_LEVEL_ERROR);
+        return runtime;
+    }
+    intp->freeComponentCount = 0;
+    intp->componentCapacity = totalComponents + 1;
+
+    intp->varIndexes = ArenaAlloc(&intp->arena, sizeof(int) * (totalOutputPins + 1));
     if (!intp->varIndexes)
     {
         intp->buildFailed = true;
         intp->buildErrorOccured = true;
-        AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Out of memory: varIndexes{I206}"}, LOG_LEVEL_ERROR);
+        AddToLogFromInterpreter(intp, "Out of memory: varIndexes{I206}", LOG_LEVEL_ERROR);
         return runtime;
     }
     intp->varCount = 0;
 
-    intp->forces = calloc(MAX_FORCES, sizeof(Force));
-    if (!intp->forces)
+    if (!GrowForceStore(&intp->forces))
     {
         intp->buildFailed = true;
         intp->buildErrorOccured = true;
-        AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Out of memory: forces{I207}"}, LOG_LEVEL_ERROR);
+        AddToLogFromInterpreter(intp, "Out of memory: forces{I207}", LOG_LEVEL_ERROR);
         return runtime;
     }
-    intp->forceCount = 0;
 
     for (int i = 0; i < graph->nodeCount; i++)
     {
@@ -392,13 +837,13 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
             {
                 intp->buildFailed = true;
                 intp->buildErrorOccured = true;
-                AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Missing input for literal node{I208}"}, LOG_LEVEL_ERROR);
+                AddToLogFromInterpreter(intp, "Missing input for literal node{I208}", LOG_LEVEL_ERROR);
                 return runtime;
             }
             intp->values[intp->valueCount].number = strtof(node->inputPins[0]->textFieldValue, NULL);
             intp->values[intp->valueCount].type = VAL_NUMBER;
             intp->values[intp->valueCount].isVariable = false;
-            intp->values[intp->valueCount].name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, srcNode->name);
+            intp->valueNames[intp->valueCount] = ArenaFormat(&intp->arena, MAX_VARIABLE_NAME_SIZE, "%s", srcNode->name);
             if (node->outputPins[0])
                 node->outputPins[0]->valueIndex = intp->valueCount;
             intp->valueCount++;
@@ -408,13 +853,13 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
             {
                 intp->buildFailed = true;
                 intp->buildErrorOccured = true;
-                AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Missing input for literal node{I208}"}, LOG_LEVEL_ERROR);
+                AddToLogFromInterpreter(intp, "Missing input for literal node{I208}", LOG_LEVEL_ERROR);
                 return runtime;
             }
-            intp->values[intp->valueCount].string = strmac(NULL, MAX_LITERAL_NODE_FIELD_SIZE - 1, node->inputPins[0]->textFieldValue);
+            intp->values[intp->valueCount].stringID = InternValueString(intp, node->inputPins[0]->textFieldValue);
             intp->values[intp->valueCount].type = VAL_STRING;
             intp->values[intp->valueCount].isVariable = false;
-            intp->values[intp->valueCount].name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, srcNode->name);
+            intp->valueNames[intp->valueCount] = ArenaFormat(&intp->arena, MAX_VARIABLE_NAME_SIZE, "%s", srcNode->name);
             if (node->outputPins[0])
                 node->outputPins[0]->valueIndex = intp->valueCount;
             intp->valueCount++;
@@ -424,7 +869,7 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
             {
                 intp->buildFailed = true;
                 intp->buildErrorOccured = true;
-                AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Missing input for literal node{I208}"}, LOG_LEVEL_ERROR);
+                AddToLogFromInterpreter(intp, "Missing input for literal node{I208}", LOG_LEVEL_ERROR);
                 return runtime;
             }
             if (strcmp(node->inputPins[0]->textFieldValue, "true") == 0)
@@ -437,7 +882,7 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
             }
             intp->values[intp->valueCount].type = VAL_BOOL;
             intp->values[intp->valueCount].isVariable = false;
-            intp->values[intp->valueCount].name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, srcNode->name);
+            intp->valueNames[intp->valueCount] = ArenaFormat(&intp->arena, MAX_VARIABLE_NAME_SIZE, "%s", srcNode->name);
             if (node->outputPins[0])
                 node->outputPins[0]->valueIndex = intp->valueCount;
             intp->valueCount++;
@@ -447,7 +892,7 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
             {
                 intp->buildFailed = true;
                 intp->buildErrorOccured = true;
-                AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Missing input for literal node{I208}"}, LOG_LEVEL_ERROR);
+                AddToLogFromInterpreter(intp, "Missing input for literal node{I208}", LOG_LEVEL_ERROR);
                 return runtime;
             }
             unsigned int hexValue;
@@ -457,7 +902,7 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
                 intp->values[intp->valueCount].color = color;
                 intp->values[intp->valueCount].type = VAL_COLOR;
                 intp->values[intp->valueCount].isVariable = false;
-                intp->values[intp->valueCount].name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, srcNode->name);
+                intp->valueNames[intp->valueCount] = ArenaFormat(&intp->arena, MAX_VARIABLE_NAME_SIZE, "%s", srcNode->name);
                 if (node->outputPins[0])
                 {
                     node->outputPins[0]->valueIndex = intp->valueCount;
@@ -467,7 +912,7 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
             else
             {
                 intp->buildErrorOccured = true;
-                AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Error: Invalid color{I209}"}, LOG_LEVEL_ERROR);
+                AddToLogFromInterpreter(intp, "Error: Invalid color{I209}", LOG_LEVEL_ERROR);
                 return runtime;
             }
             continue;
@@ -501,38 +946,45 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
                 intp->values[idx].number = 0;
                 intp->values[idx].type = VAL_NUMBER;
                 intp->values[idx].isVariable = isVariable;
-                intp->values[idx].name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, srcNode->name);
+                intp->valueNames[idx] = ArenaFormat(&intp->arena, MAX_VARIABLE_NAME_SIZE, "%s", srcNode->name);
                 break;
             case PIN_STRING:
-                intp->values[idx].string = strmac(NULL, MAX_VARIABLE_NAME_SIZE, "null");
+                if (node->type == NODE_CAST_TO_STRING)
+                {
+                    // Rewritten on every cast instead of interning each formatted result
+                    intp->values[idx].stringID = AddOwnedString(&intp->strings, &intp->arena, MAX_LITERAL_NODE_FIELD_SIZE);
+                    SetOwnedString(&intp->strings, intp->values[idx].stringID, "null");
+                }
+                else
+                {
+                    intp->values[idx].stringID = InternValueString(intp, "null");
+                }
                 intp->values[idx].type = VAL_STRING;
                 intp->values[idx].isVariable = isVariable;
-                intp->values[idx].name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, srcNode->name);
+                intp->valueNames[idx] = ArenaFormat(&intp->arena, MAX_VARIABLE_NAME_SIZE, "%s", srcNode->name);
                 break;
             case PIN_BOOL:
                 intp->values[idx].boolean = false;
                 intp->values[idx].type = VAL_BOOL;
                 intp->values[idx].isVariable = isVariable;
-                intp->values[idx].name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, srcNode->name);
+                intp->valueNames[idx] = ArenaFormat(&intp->arena, MAX_VARIABLE_NAME_SIZE, "%s", srcNode->name);
                 break;
             case PIN_COLOR:
                 intp->values[idx].color = WHITE;
                 intp->values[idx].type = VAL_COLOR;
                 intp->values[idx].isVariable = isVariable;
-                intp->values[idx].name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, srcNode->name);
+                intp->valueNames[idx] = ArenaFormat(&intp->arena, MAX_VARIABLE_NAME_SIZE, "%s", srcNode->name);
                 break;
             case PIN_SPRITE:
-                intp->values[idx].sprite = (Sprite){0};
+                intp->values[idx].componentIndex = -1;
                 intp->values[idx].type = VAL_SPRITE;
                 intp->values[idx].isVariable = isVariable;
-                intp->values[idx].name = strmac(NULL, MAX_VARIABLE_NAME_SIZE, srcNode->name);
+                intp->valueNames[idx] = ArenaFormat(&intp->arena, MAX_VARIABLE_NAME_SIZE, "%s", srcNode->name);
                 break;
             default:
                 break;
             }
 
-            intp->values[idx].componentIndex = -1;
-
             if (isVariable)
             {
                 intp->varIndexes[intp->varCount] = idx;
@@ -543,7 +995,7 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
             {
                 intp->buildFailed = true;
                 intp->buildErrorOccured = true;
-                AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Value array overflow{I20A}"}, LOG_LEVEL_ERROR);
+                AddToLogFromInterpreter(intp, "Value array overflow{I20A}", LOG_LEVEL_ERROR);
                 return runtime;
             }
 
@@ -552,56 +1004,57 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
         }
     }
 
-    if (intp->varCount > 0)
+    if (intp->arena.hasFailed || intp->strings.hasFailed)
+    {
+        intp->buildFailed = true;
+        intp->buildErrorOccured = true;
+        AddToLogFromInterpreter(intp, "Out of memory: strings{I216}", LOG_LEVEL_ERROR);
+        return runtime;
+    }
+
+    int *nodeIndexByVariable = MapVariablesToNodes(graph, &intp->arena);
+    if (!nodeIndexByVariable)
     {
-        int *tmp = realloc(intp->varIndexes, sizeof(int) * intp->varCount);
-        if (tmp)
-            intp->varIndexes = tmp;
+        intp->buildFailed = true;
+        intp->buildErrorOccured = true;
+        AddToLogFromInterpreter(intp, "Out of memory: variables{I223}", LOG_LEVEL_ERROR);
+        return runtime;
     }
 
     for (int i = 0; i < graph->nodeCount; i++)
     {
         RuntimeNode *node = &runtime.nodes[i];
-        Node *srcNode = &graph->nodes[i];
-
-        bool valueFound = false;
 
         switch (graph->nodes[i].type)
         {
         case NODE_GET_VARIABLE:
-            for (int j = 0; j < graph->nodeCount; j++)
-            {
-                if (j != i && runtime.nodes[i].inputPins[0] && runtime.nodes[i].inputPins[0]->pickedOption < 256 && strcmp(graph->variables[runtime.nodes[i].inputPins[0]->pickedOption], graph->nodes[j].name) == 0)
-                {
-                    if (runtime.nodes[j].outputPins[1])
-                        node->outputPins[0]->valueIndex = runtime.nodes[j].outputPins[1]->valueIndex;
-                    valueFound = true;
-                    break;
-                }
-            }
-            if (!valueFound)
+        {
+            int variableNodeIndex = GetVariableNodeIndex(graph, nodeIndexByVariable, node->inputPins[0]);
+            if (variableNodeIndex == -1)
             {
                 if (node->outputPins[0])
                     node->outputPins[0]->valueIndex = 0;
             }
-            continue;
-        case NODE_SET_VARIABLE:
-            for (int j = 0; j < graph->nodeCount; j++)
+            else if (runtime.nodes[variableNodeIndex].outputPins[1])
             {
-                if (j != i && runtime.nodes[i].inputPins[1] && runtime.nodes[i].inputPins[1]->pickedOption < 256 && strcmp(graph->variables[runtime.nodes[i].inputPins[1]->pickedOption], graph->nodes[j].name) == 0)
-                {
-                    if (runtime.nodes[j].outputPins[1])
-                        node->outputPins[1]->valueIndex = runtime.nodes[j].outputPins[1]->valueIndex;
-                    valueFound = true;
-                    break;
-                }
+                node->outputPins[0]->valueIndex = runtime.nodes[variableNodeIndex].outputPins[1]->valueIndex;
             }
-            if (!valueFound)
+            continue;
+        }
+        case NODE_SET_VARIABLE:
+        {
+            int variableNodeIndex = GetVariableNodeIndex(graph, nodeIndexByVariable, node->inputPins[1]);
+            if (variableNodeIndex == -1)
             {
                 if (node->outputPins[1])
                     node->outputPins[1]->valueIndex = 0;
             }
+            else if (runtime.nodes[variableNodeIndex].outputPins[1])
+            {
+                node->outputPins[1]->valueIndex = runtime.nodes[variableNodeIndex].outputPins[1]->valueIndex;
+            }
             continue;
+        }
         case NODE_GET_SCREEN_WIDTH:
             if (node->outputPins[0])
             {
@@ -641,22 +1094,14 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
 
     for (int i = 0; i < graph->linkCount; i++)
     {
-        int inputIndex = -1;
-        int outputIndex = -1;
-
-        for (int j = 0; j < graph->pinCount && (inputIndex == -1 || outputIndex == -1); j++)
-        {
-            if (graph->pins[j].id == graph->links[i].inputPinID)
-                inputIndex = j;
-            if (graph->pins[j].id == graph->links[i].outputPinID)
-                outputIndex = j;
-        }
+        int inputIndex = FindPinIndexByID(graph, graph->links[i].inputPinID);
+        int outputIndex = FindPinIndexByID(graph, graph->links[i].outputPinID);
 
         if (inputIndex == -1 || outputIndex == -1)
         {
             intp->buildFailed = true;
             intp->buildErrorOccured = true;
-            AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Link pin missing{I20B}"}, LOG_LEVEL_ERROR);
+            AddToLogFromInterpreter(intp, "Link pin missing{I20B}", LOG_LEVEL_ERROR);
             return runtime;
         }
 
@@ -672,6 +1117,22 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
         }
     }
 
+    PreloadGraphAssets(intp, &runtime);
+
+    // Component of each Create Sprite value, so sprite variable pins are bound in one pass over the pins
+    int *componentIndexByValue = ArenaAlloc(&intp->arena, sizeof(int) * intp->valueCount);
+    if (!componentIndexByValue)
+    {
+        intp->buildFailed = true;
+        intp->buildErrorOccured = true;
+        AddToLogFromInterpreter(intp, "Out of memory: sprite variables{I224}", LOG_LEVEL_ERROR);
+        return runtime;
+    }
+    for (int i = 0; i < intp->valueCount; i++)
+    {
+        componentIndexByValue[i] = -1;
+    }
+
     for (int i = 0; i < graph->nodeCount; i++)
     {
         RuntimeNode *node = &runtime.nodes[i];
@@ -682,6 +1143,8 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
         {
             intp->components[intp->componentCount].isSprite = true;
             intp->components[intp->componentCount].isVisible = false;
+            intp->components[intp->componentCount].sprite.textureHandle = TEXTURE_HANDLE_NONE;
+            intp->components[intp->componentCount].lastInstance = -1;
             int fileIndex = -1;
             int wIndex = -1;
             int hIndex = -1;
@@ -699,26 +1162,27 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
                 hIndex = node->inputPins[3]->valueIndex;
             }
 
-            if (fileIndex != -1 && fileIndex < intp->valueCount && intp->values[fileIndex].string && intp->values[fileIndex].string[0])
+            if (fileIndex != -1 && fileIndex < intp->valueCount && GetInternedStringLength(&intp->strings, intp->values[fileIndex].stringID) > 0)
             {
                 char path[MAX_FILE_PATH];
-                strmac(path, MAX_FILE_PATH, "%s%c%s", intp->projectPath, PATH_SEPARATOR, intp->values[fileIndex].string);
-                Texture2D tex = LoadTexture(path);
-                if (tex.id == 0)
+                strmac(path, MAX_FILE_PATH, "%s%c%s", intp->projectPath, PATH_SEPARATOR, GetValueString(intp, intp->values[fileIndex]));
+                int textureHandle = AcquireTexture(&intp->textures, &intp->arena, path);
+                if (textureHandle == TEXTURE_HANDLE_NONE)
                 {
                     intp->buildErrorOccured = true;
-                    AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Failed to load texture{I20C}"}, LOG_LEVEL_ERROR);
+                    AddToLogFromInterpreter(intp, "Failed to load texture{I20C}", LOG_LEVEL_ERROR);
                     return runtime;
                 }
                 else
                 {
-                    intp->components[intp->componentCount].sprite.texture = tex;
+                    intp->components[intp->componentCount].sprite.textureHandle = textureHandle;
+                    intp->components[intp->componentCount].sprite.texture = GetCachedTexture(&intp->textures, textureHandle);
                 }
             }
             else
             {
                 intp->buildErrorOccured = true;
-                AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Invalid texture input{I20D}"}, LOG_LEVEL_ERROR);
+                AddToLogFromInterpreter(intp, "Invalid texture input{I20D}", LOG_LEVEL_ERROR);
                 return runtime;
             }
 
@@ -733,49 +1197,18 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
 
             intp->components[intp->componentCount].sprite.hitbox.type = HITBOX_POLY;
 
-            for (int j = 0; j < graph->pinCount; j++)
+            int hitboxPinIndex = graph->nodes[i].inputPins[5] ? FindPinIndexByID(graph, graph->nodes[i].inputPins[5]) : -1;
+            if (hitboxPinIndex != -1)
             {
-                if (graph->nodes[i].inputPins[5] && graph->pins[j].id == graph->nodes[i].inputPins[5])
-                {
-                    intp->components[intp->componentCount].sprite.hitbox.polygonHitbox = graph->pins[j].hitbox;
-                }
+                intp->components[intp->componentCount].sprite.hitbox.polygonHitbox = graph->pins[hitboxPinIndex].hitbox;
             }
 
             if (node->outputPins[1])
-                node->outputPins[1]->componentIndex = intp->componentCount;
-
-            for (int j = 0; j < runtime.nodeCount; j++)
             {
-                for (int k = 0; k < runtime.nodes[j].inputCount; k++)
+                node->outputPins[1]->componentIndex = intp->componentCount;
+                if (node->outputPins[1]->valueIndex >= 0 && node->outputPins[1]->valueIndex < intp->valueCount)
                 {
-                    if (!runtime.nodes[j].inputPins[k])
-                    {
-                        continue;
-                    }
-                    if (runtime.nodes[j].inputPins[k]->type == PIN_SPRITE_VARIABLE && runtime.nodes[j].inputPins[k]->pickedOption != 0)
-                    {
-                        const char *varPtr = graph->nodes[i].name;
-                        int picked = runtime.nodes[j].inputPins[k]->pickedOption - 1;
-                        if (picked < 0 || picked >= intp->varCount)
-                        {
-                            continue;
-                        }
-                        const char *valPtr = intp->values[intp->varIndexes[picked]].name;
-
-                        if (varPtr && valPtr)
-                        {
-                            char varName[MAX_VARIABLE_NAME_SIZE];
-                            char valName[MAX_VARIABLE_NAME_SIZE];
-                            strmac(varName, MAX_VARIABLE_NAME_SIZE, "%s", varPtr);
-                            strmac(valName, MAX_VARIABLE_NAME_SIZE, "%s", valPtr);
-
-                            if (strcmp(varName, valName) == 0)
-                            {
-                                intp->values[intp->varIndexes[picked]].componentIndex = intp->componentCount;
-                                runtime.nodes[j].inputPins[k]->valueIndex = intp->varIndexes[picked];
-                            }
-                        }
-                    }
+                    componentIndexByValue[node->outputPins[1]->valueIndex] = intp->componentCount;
                 }
             }
 
@@ -843,46 +1276,51 @@ RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContex
         }
     }
 
-    return runtime;
-}
-
-int DoesForceExist(InterpreterContext *intp, int id)
-{
-    for (int i = 0; i < intp->forceCount; i++)
+    for (int i = 0; i < runtime.pinCount; i++)
     {
-        if (intp->forces[i].id == id)
+        RuntimePin *pin = &runtime.pins[i];
+        if (pin->nodeIndex < 0 || !pin->isInput || pin->type != PIN_SPRITE_VARIABLE || pin->pickedOption <= 0 || pin->pickedOption > intp->varCount)
         {
-            return i;
+            continue;
         }
-    }
-    return -1;
-}
 
-void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, RuntimeGraphContext *graph, int outFlowPinIndexInNode)
-{
-    if (lastNodeIndex < 0 || lastNodeIndex >= graph->nodeCount)
-    {
-        return;
+        int valueIndex = intp->varIndexes[pin->pickedOption - 1];
+        if (componentIndexByValue[valueIndex] != -1)
+        {
+            intp->values[valueIndex].componentIndex = componentIndexByValue[valueIndex];
+            pin->valueIndex = valueIndex;
+        }
     }
 
-    if (graph->nodes[lastNodeIndex].outputCount == 0 || graph->nodes[lastNodeIndex].outputPins[outFlowPinIndexInNode]->nextNodeIndex == -1)
-    {
-        return;
-    }
+    return runtime;
+}
 
-    int currNodeIndex = graph->nodes[lastNodeIndex].outputPins[outFlowPinIndexInNode]->nextNodeIndex;
-    if (currNodeIndex < 0 || currNodeIndex >= graph->nodeCount)
+static void AddDebugLine(InterpreterContext *intp, DebugLine line)
+{
+    DebugLineList *list = intp->isRunningStep ? &intp->stepDebugLines : &intp->frameDebugLines;
+    if (list->count >= list->capacity)
     {
-        return;
+        int newCapacity = list->capacity ? list->capacity * 2 : INITIAL_DEBUG_LINE_CAPACITY;
+        DebugLine *newLines = realloc(list->lines, sizeof(DebugLine) * newCapacity);
+        if (!newLines)
+        {
+            AddToLogFromInterpreter(intp, "Out of memory: debug lines{I222}", LOG_LEVEL_ERROR);
+            return;
+        }
+        list->lines = newLines;
+        list->capacity = newCapacity;
     }
 
-    RuntimeNode *node = &graph->nodes[currNodeIndex];
+    list->lines[list->count++] = line;
+}
 
+void ExecuteNode(InterpreterContext *intp, RuntimeNode *node)
+{
     switch (node->type)
     {
     case NODE_UNKNOWN:
     {
-        AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Unknown node{I20E}"}, LOG_LEVEL_ERROR);
+        AddToLogFromInterpreter(intp, "Unknown node{I20E}", LOG_LEVEL_ERROR);
         break;
     }
 
@@ -901,9 +1339,7 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
     {
         if (node->inputPins[1]->valueIndex != -1)
         {
-            char **strToSet = &intp->values[node->outputPins[1]->valueIndex].string;
-            char *newStr = intp->values[node->inputPins[1]->valueIndex].string;
-            *strToSet = newStr;
+            intp->values[node->outputPins[1]->valueIndex].stringID = CopyString(&intp->strings, &intp->arena, intp->values[node->inputPins[1]->valueIndex].stringID);
         }
         break;
     }
@@ -946,21 +1382,21 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
             newVal->number = val.number;
             break;
         case VAL_STRING:
-            newVal->number = strlen(val.string);
+            newVal->number = GetInternedStringLength(&intp->strings, val.stringID);
             break;
         case VAL_BOOL:
             newVal->number = val.boolean;
             break;
         case VAL_COLOR:
             newVal->number = 0;
-            AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Can't cast Color to Number{I108}"}, LOG_LEVEL_WARNING);
+            AddToLogFromInterpreter(intp, "Can't cast Color to Number{I108}", LOG_LEVEL_WARNING);
             break;
         case VAL_SPRITE:
             newVal->number = 0;
-            AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Can't cast Sprite to Number{I109}"}, LOG_LEVEL_WARNING);
+            AddToLogFromInterpreter(intp, "Can't cast Sprite to Number{I109}", LOG_LEVEL_WARNING);
             break;
         default:
-            AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Unknown pin type{I113}"}, LOG_LEVEL_WARNING);
+            AddToLogFromInterpreter(intp, "Unknown pin type{I113}", LOG_LEVEL_WARNING);
             break;
         }
 
@@ -980,22 +1416,25 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
         switch (val.type)
         {
         case VAL_NUMBER:
-            strmac(newVal->string, MAX_LITERAL_NODE_FIELD_SIZE, "%.2f", val.number);
+            SetOwnedString(&intp->strings, newVal->stringID, TextFormat("%.2f", val.number));
             break;
         case VAL_STRING:
-            strmac(newVal->string, MAX_LITERAL_NODE_FIELD_SIZE, "%s", val.string);
+            SetOwnedString(&intp->strings, newVal->stringID, GetValueString(intp, val));
             break;
         case VAL_BOOL:
-            strmac(newVal->string, MAX_LITERAL_NODE_FIELD_SIZE, "%s", val.boolean ? "true" : "false");
+            SetOwnedString(&intp->strings, newVal->stringID, val.boolean ? "true" : "false");
             break;
         case VAL_COLOR:
-            strmac(newVal->string, MAX_LITERAL_NODE_FIELD_SIZE, "R:%d G:%d B:%d A:%d", val.color.r, val.color.g, val.color.b, val.color.a);
+            SetOwnedString(&intp->strings, newVal->stringID, TextFormat("R:%d G:%d B:%d A:%d", val.color.r, val.color.g, val.color.b, val.color.a));
             break;
         case VAL_SPRITE:
-            strmac(newVal->string, MAX_LOG_MESSAGE_SIZE, "%s, PosX: %.0f, PosY: %.0f, Rotation: %.2f", val.sprite.isVisible ? "Visible" : "Not visible", val.sprite.position.x, val.sprite.position.y, val.sprite.rotation);
+        {
+            const SceneComponent *component = GetValueComponent(intp, val);
+            SetOwnedString(&intp->strings, newVal->stringID, TextFormat("%s, PosX: %.0f, PosY: %.0f, Rotation: %.2f", component->isVisible ? "Visible" : "Not visible", component->sprite.position.x, component->sprite.position.y, component->sprite.rotation));
             break;
+        }
         default:
-            AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Unknown pin type{I113}"}, LOG_LEVEL_WARNING);
+            AddToLogFromInterpreter(intp, "Unknown pin type{I113}", LOG_LEVEL_WARNING);
             break;
         }
 
@@ -1018,7 +1457,7 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
             newVal->boolean = val.number > 0;
             break;
         case VAL_STRING:
-            newVal->boolean = strlen(val.string) > 0;
+            newVal->boolean = GetInternedStringLength(&intp->strings, val.stringID) > 0;
             break;
         case VAL_BOOL:
             newVal->boolean = val.boolean;
@@ -1027,10 +1466,10 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
             newVal->boolean = val.color.a != 0;
             break;
         case VAL_SPRITE:
-            newVal->boolean = val.sprite.isVisible;
+            newVal->boolean = GetValueComponent(intp, val)->isVisible;
             break;
         default:
-            AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Unknown pin type{I113}"}, LOG_LEVEL_WARNING);
+            AddToLogFromInterpreter(intp, "Unknown pin type{I113}", LOG_LEVEL_WARNING);
             break;
         }
 
@@ -1051,12 +1490,12 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
         {
         case VAL_NUMBER:
             newVal->color = BLACK;
-            AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Can't cast Number to Color{I110}"}, LOG_LEVEL_WARNING);
+            AddToLogFromInterpreter(intp, "Can't cast Number to Color{I110}", LOG_LEVEL_WARNING);
             break;
         case VAL_STRING:
         {
             unsigned int hexValue;
-            if (sscanf(val.string, "%x", &hexValue) == 1)
+            if (sscanf(GetValueString(intp, val), "%x", &hexValue) == 1)
             {
                 newVal->color = (Color){
                     (hexValue >> 24) & 0xFF,
@@ -1067,23 +1506,23 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
             else
             {
                 newVal->color = BLACK;
-                AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Error: Invalid color{I209}"}, LOG_LEVEL_ERROR);
+                AddToLogFromInterpreter(intp, "Error: Invalid color{I209}", LOG_LEVEL_ERROR);
             }
             break;
         }
         case VAL_BOOL:
             newVal->color = BLACK;
-            AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Can't cast Bool to Color{I111}"}, LOG_LEVEL_WARNING);
+            AddToLogFromInterpreter(intp, "Can't cast Bool to Color{I111}", LOG_LEVEL_WARNING);
             break;
         case VAL_COLOR:
             newVal->color = val.color;
             break;
         case VAL_SPRITE:
             newVal->color = BLACK;
-            AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Can't cast Sprite to Color{I112}"}, LOG_LEVEL_WARNING);
+            AddToLogFromInterpreter(intp, "Can't cast Sprite to Color{I112}", LOG_LEVEL_WARNING);
             break;
         default:
-            AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Unknown pin type{I113}"}, LOG_LEVEL_WARNING);
+            AddToLogFromInterpreter(intp, "Unknown pin type{I113}", LOG_LEVEL_WARNING);
             break;
         }
 
@@ -1114,12 +1553,13 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
 
     case NODE_GET_SPRITE_POSITION:
     {
-        if (intp->values[node->inputPins[1]->valueIndex].componentIndex != -1 && intp->values[node->inputPins[1]->valueIndex].componentIndex < intp->componentCount)
+        int componentIndex = GetSpriteComponentIndex(intp, node->inputPins[1]->valueIndex);
+        if (componentIndex != -1)
         {
             if (node->outputPins[1]->valueIndex != -1 && node->outputPins[2]->valueIndex != -1)
             {
-                intp->values[node->outputPins[1]->valueIndex].number = intp->components[intp->values[node->inputPins[1]->valueIndex].componentIndex].sprite.position.x;
-                intp->values[node->outputPins[2]->valueIndex].number = intp->components[intp->values[node->inputPins[1]->valueIndex].componentIndex].sprite.position.y;
+                intp->values[node->outputPins[1]->valueIndex].number = intp->components[componentIndex].sprite.position.x;
+                intp->values[node->outputPins[2]->valueIndex].number = intp->components[componentIndex].sprite.position.y;
             }
         }
         break;
@@ -1137,7 +1577,7 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
                 valToSet->number = newValue.number;
                 break;
             case VAL_STRING:
-                valToSet->string = newValue.string;
+                valToSet->stringID = CopyString(&intp->strings, &intp->arena, newValue.stringID);
                 break;
             case VAL_BOOL:
                 valToSet->boolean = newValue.boolean;
@@ -1145,9 +1585,6 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
             case VAL_COLOR:
                 valToSet->color = newValue.color;
                 break;
-            case VAL_SPRITE:
-                valToSet->sprite = newValue.sprite;
-                break;
             default:
                 break;
             }
@@ -1173,98 +1610,15 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
         break;
     }
 
-    case NODE_BRANCH:
-    {
-        if (node->inputPins[1]->valueIndex != -1)
-        {
-            bool *condition = &intp->values[node->inputPins[1]->valueIndex].boolean;
-            if (*condition)
-            {
-                InterpretStringOfNodes(currNodeIndex, intp, graph, 0);
-            }
-            else
-            {
-                InterpretStringOfNodes(currNodeIndex, intp, graph, 1);
-            }
-        }
-        return;
-    }
-
-    case NODE_LOOP:
-    {
-        int steps = MAX_ITERATIONS_BEFORE_ILP;
-        if (node->inputPins[1]->valueIndex != -1)
-        {
-            bool *condition = &intp->values[node->inputPins[1]->valueIndex].boolean;
-            while (*condition)
-            {
-                if (steps == 0)
-                {
-                    if (intp->isInfiniteLoopProtectionOn)
-                    {
-                        AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Possible infinite loop detected and exited! You can turn off infinite loop protection in settings{I210}"}, LOG_LEVEL_ERROR);
-                        break;
-                    }
-                    else
-                    {
-                        AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Possible infinite loop detected! Infinite loop protection is off!{I101}"}, LOG_LEVEL_WARNING);
-                    }
-                }
-                else
-                {
-                    steps--;
-                }
-                InterpretStringOfNodes(currNodeIndex, intp, graph, 1);
-                if (intp->shouldBreakFromLoop)
-                {
-                    intp->shouldBreakFromLoop = false;
-                    break;
-                }
-            }
-        }
-        break;
-    }
-
-    case NODE_FLIP_FLOP:
-    {
-        if (node->flipFlopState)
-        {
-            InterpretStringOfNodes(currNodeIndex, intp, graph, 0);
-        }
-        else
-        {
-            InterpretStringOfNodes(currNodeIndex, intp, graph, 1);
-        }
-
-        node->flipFlopState = !node->flipFlopState;
-        return;
-        break;
-    }
-
-    case NODE_BREAK:
-    {
-        intp->shouldBreakFromLoop = true;
-        return;
-        break;
-    }
-
-    case NODE_SEQUENCE:
-    {
-        InterpretStringOfNodes(currNodeIndex, intp, graph, 0);
-        InterpretStringOfNodes(currNodeIndex, intp, graph, 1);
-        InterpretStringOfNodes(currNodeIndex, intp, graph, 2);
-        return;
-        break;
-    }
-
     case NODE_CREATE_SPRITE:
     {
-        if (node->outputPins[1]->valueIndex == -1)
+        int componentIndex = node->outputPins[1]->componentIndex;
+        if (node->outputPins[1]->valueIndex == -1 || componentIndex == -1)
         {
             break;
         }
 
-        Sprite *sprite = &intp->values[node->outputPins[1]->valueIndex].sprite;
+        Sprite *sprite = &intp->components[componentIndex].sprite;
         if (node->inputPins[2]->valueIndex != -1)
         {
             sprite->width = intp->values[node->inputPins[2]->valueIndex].number;
@@ -1277,85 +1631,117 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
         {
             sprite->layer = node->inputPins[4]->pickedOption;
         }
-        if (node->outputPins[1]->componentIndex != -1)
-        {
-            Texture2D tempTex = intp->components[node->outputPins[1]->componentIndex].sprite.texture;
-            Polygon tempHitbox = intp->components[node->outputPins[1]->componentIndex].sprite.hitbox.polygonHitbox;
-            intp->components[node->outputPins[1]->componentIndex].sprite = *sprite;
-            intp->components[node->outputPins[1]->componentIndex].sprite.texture = tempTex;
-            intp->components[node->outputPins[1]->componentIndex].sprite.hitbox.type = HITBOX_POLY;
-            intp->components[node->outputPins[1]->componentIndex].sprite.hitbox.polygonHitbox = tempHitbox;
-        }
+        sprite->hitbox.type = HITBOX_POLY;
+        UpdateComponentTransform(intp, componentIndex);
         break;
     }
 
     case NODE_SPAWN_SPRITE:
+    case NODE_SPAWN_SPRITE_INSTANCE:
     {
-        if (intp->values[node->inputPins[1]->valueIndex].componentIndex != -1 && intp->values[node->inputPins[1]->valueIndex].componentIndex < intp->componentCount)
+        int componentIndex = GetSpriteComponentIndex(intp, node->inputPins[1]->valueIndex);
+
+        // Spawn shows the sprite itself, Spawn instance shows a pooled copy and the variable then refers to the copy
+        if (componentIndex != -1 && node->type == NODE_SPAWN_SPRITE_INSTANCE)
+        {
+            SceneComponent *component = &intp->components[componentIndex];
+            int instanceIndex = SpawnSpriteInstance(intp, component->isInstance ? component->templateIndex : componentIndex);
+            if (instanceIndex == -1)
+            {
+                AddToLogFromInterpreter(intp, "Out of memory: sprite not spawned{I116}", LOG_LEVEL_WARNING);
+                break;
+            }
+            intp->values[node->inputPins[1]->valueIndex].componentIndex = instanceIndex;
+            componentIndex = instanceIndex;
+        }
+
+        if (componentIndex != -1)
         {
-            intp->components[intp->values[node->inputPins[1]->valueIndex].componentIndex].isVisible = true;
+            intp->components[componentIndex].isVisible = true;
             if (node->inputPins[2]->valueIndex != -1)
             {
-                intp->components[intp->values[node->inputPins[1]->valueIndex].componentIndex].sprite.position.x = intp->values[node->inputPins[2]->valueIndex].number;
+                intp->components[componentIndex].sprite.position.x = intp->values[node->inputPins[2]->valueIndex].number;
             }
             if (node->inputPins[3]->valueIndex != -1)
             {
-                intp->components[intp->values[node->inputPins[1]->valueIndex].componentIndex].sprite.position.y = intp->values[node->inputPins[3]->valueIndex].number;
+                intp->components[componentIndex].sprite.position.y = intp->values[node->inputPins[3]->valueIndex].number;
             }
             if (node->inputPins[4]->valueIndex != -1)
             {
-                intp->components[intp->values[node->inputPins[1]->valueIndex].componentIndex].sprite.rotation = -1 * (intp->values[node->inputPins[4]->valueIndex].number - 360);
+                intp->components[componentIndex].sprite.rotation = -1 * (intp->values[node->inputPins[4]->valueIndex].number - 360);
             }
+            UpdateComponentTransform(intp, componentIndex);
+            SnapSpriteInterpolation(intp, componentIndex);
         }
         break;
     }
 
     case NODE_DESTROY_SPRITE:
     {
-        if (intp->values[node->inputPins[1]->valueIndex].componentIndex != -1 && intp->values[node->inputPins[1]->valueIndex].componentIndex < intp->componentCount)
+        int componentIndex = GetSpriteComponentIndex(intp, node->inputPins[1]->valueIndex);
+        if (componentIndex != -1 && intp->components[componentIndex].isInstance)
+        {
+            intp->values[node->inputPins[1]->valueIndex].componentIndex = DestroySpriteInstance(intp, componentIndex);
+        }
+        else if (componentIndex != -1)
         {
-            intp->components[intp->values[node->inputPins[1]->valueIndex].componentIndex].isVisible = false;
+            intp->components[componentIndex].isVisible = false;
         }
         break;
     }
 
     case NODE_SET_SPRITE_POSITION:
     {
-        if (intp->values[node->inputPins[1]->valueIndex].componentIndex != -1 && intp->values[node->inputPins[1]->valueIndex].componentIndex < intp->componentCount)
+        int componentIndex = GetSpriteComponentIndex(intp, node->inputPins[1]->valueIndex);
+        if (componentIndex != -1)
         {
-            intp->components[intp->values[node->inputPins[1]->valueIndex].componentIndex].sprite.position.x = intp->values[node->inputPins[2]->valueIndex].number;
-            intp->components[intp->values[node->inputPins[1]->valueIndex].componentIndex].sprite.position.y = intp->values[node->inputPins[3]->valueIndex].number;
+            intp->components[componentIndex].sprite.position.x = intp->values[node->inputPins[2]->valueIndex].number;
+            intp->components[componentIndex].sprite.position.y = intp->values[node->inputPins[3]->valueIndex].number;
+            UpdateComponentTransform(intp, componentIndex);
+            SnapSpriteInterpolation(intp, componentIndex);
         }
         break;
     }
 
     case NODE_SET_SPRITE_ROTATION:
     {
-        if (intp->values[node->inputPins[1]->valueIndex].componentIndex != -1 && intp->values[node->inputPins[1]->valueIndex].componentIndex < intp->componentCount)
+        int componentIndex = GetSpriteComponentIndex(intp, node->inputPins[1]->valueIndex);
+        if (componentIndex != -1)
         {
-            intp->components[intp->values[node->inputPins[1]->valueIndex].componentIndex].sprite.rotation = -1 * (intp->values[node->inputPins[2]->valueIndex].number - 360);
+            intp->components[componentIndex].sprite.rotation = -1 * (intp->values[node->inputPins[2]->valueIndex].number - 360);
         }
         break;
     }
 
     case NODE_SET_SPRITE_TEXTURE:
     {
-        if (intp->values[node->inputPins[1]->valueIndex].componentIndex != -1 && intp->values[node->inputPins[1]->valueIndex].componentIndex < intp->componentCount)
+        int componentIndex = GetSpriteComponentIndex(intp, node->inputPins[1]->valueIndex);
+        if (componentIndex != -1)
         {
-            UnloadTexture(intp->components[intp->values[node->inputPins[1]->valueIndex].componentIndex].sprite.texture);
             char path[MAX_FILE_PATH];
-            strmac(path, MAX_FILE_PATH, "%s%c%s", intp->projectPath, PATH_SEPARATOR, intp->values[node->inputPins[2]->valueIndex].string);
-            intp->components[intp->values[node->inputPins[1]->valueIndex].componentIndex].sprite.texture = LoadTexture(path);
+            strmac(path, MAX_FILE_PATH, "%s%c%s", intp->projectPath, PATH_SEPARATOR, GetValueString(intp, intp->values[node->inputPins[2]->valueIndex]));
+
+            // Sprites keep their current texture if the new one can't be loaded
+            int textureHandle = AcquireTexture(&intp->textures, &intp->arena, path);
+            if (textureHandle != TEXTURE_HANDLE_NONE)
+            {
+                Sprite *sprite = &intp->components[componentIndex].sprite;
+                sprite->textureHandle = textureHandle;
+                sprite->texture = GetCachedTexture(&intp->textures, textureHandle);
+                UpdateComponentTransform(intp, componentIndex);
+            }
         }
         break;
     }
 
     case NODE_SET_SPRITE_SIZE:
     {
-        if (intp->values[node->inputPins[1]->valueIndex].componentIndex != -1 && intp->values[node->inputPins[1]->valueIndex].componentIndex < intp->componentCount)
+        int componentIndex = GetSpriteComponentIndex(intp, node->inputPins[1]->valueIndex);
+        if (componentIndex != -1)
         {
-            intp->components[intp->values[node->inputPins[1]->valueIndex].componentIndex].sprite.width = intp->values[node->inputPins[2]->valueIndex].number;
-            intp->components[intp->values[node->inputPins[1]->valueIndex].componentIndex].sprite.height = intp->values[node->inputPins[3]->valueIndex].number;
+            intp->components[componentIndex].sprite.width = intp->values[node->inputPins[2]->valueIndex].number;
+            intp->components[componentIndex].sprite.height = intp->values[node->inputPins[3]->valueIndex].number;
+            UpdateComponentTransform(intp, componentIndex);
         }
         break;
     }
@@ -1367,22 +1753,27 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
 
     case NODE_FORCE_SPRITE:
     {
-        if (intp->values[node->inputPins[1]->valueIndex].componentIndex != -1)
+        int componentIndex = GetSpriteComponentIndex(intp, node->inputPins[1]->valueIndex);
+        if (componentIndex != -1)
         {
-            SceneComponent *component = &intp->components[intp->values[node->inputPins[1]->valueIndex].componentIndex];
-            int forceIndex = DoesForceExist(intp, node->index);
-            if (forceIndex != -1)
+            int generation = intp->components[componentIndex].generation;
+            int pixelsPerSecond = (int)intp->values[node->inputPins[2]->valueIndex].number;
+            int angle = (int)intp->values[node->inputPins[3]->valueIndex].number;
+            float duration = intp->values[node->inputPins[4]->valueIndex].number;
+
+            int forceIndex = FindForce(&intp->forces, node->index, componentIndex);
+            if (forceIndex != -1 && intp->forces.generations[forceIndex] == generation)
+            {
+                intp->forces.durations[forceIndex] = duration;
+            }
+            else if (forceIndex != -1)
             {
-                intp->forces[forceIndex].duration = intp->values[node->inputPins[4]->valueIndex].number;
+                // Left over from an instance that was destroyed before HandleForces noticed, the slot is a new sprite now
+                SetForce(&intp->forces, forceIndex, generation, pixelsPerSecond, angle, duration);
             }
-            else if (intp->values[node->inputPins[1]->valueIndex].componentIndex >= 0 && intp->values[node->inputPins[1]->valueIndex].componentIndex < intp->componentCount)
+            else if (!AddForce(&intp->forces, node->index, componentIndex, generation, pixelsPerSecond, angle, duration))
             {
-                intp->forces[intp->forceCount].id = node->index;
-                intp->forces[intp->forceCount].componentIndex = intp->values[node->inputPins[1]->valueIndex].componentIndex;
-                intp->forces[intp->forceCount].pixelsPerSecond = intp->values[node->inputPins[2]->valueIndex].number;
-                intp->forces[intp->forceCount].angle = intp->values[node->inputPins[3]->valueIndex].number;
-                intp->forces[intp->forceCount].duration = intp->values[node->inputPins[4]->valueIndex].number;
-                intp->forceCount++;
+                AddToLogFromInterpreter(intp, "Out of memory: force not applied{I115}", LOG_LEVEL_WARNING);
             }
         }
         break;
@@ -1584,7 +1975,7 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
     {
         if (node->inputPins[1]->valueIndex != -1)
         {
-            AddToLogFromInterpreter(intp, intp->values[node->inputPins[1]->valueIndex], LOG_LEVEL_DEBUG);
+            AddToLogFromInterpreter(intp, ValueToString(intp, intp->values[node->inputPins[1]->valueIndex]), LOG_LEVEL_DEBUG);
         }
         break;
     }
@@ -1595,12 +1986,10 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
         {
             break;
         }
-        DrawLine(
-            intp->values[node->inputPins[1]->valueIndex].number,
-            intp->values[node->inputPins[2]->valueIndex].number,
-            intp->values[node->inputPins[3]->valueIndex].number,
-            intp->values[node->inputPins[4]->valueIndex].number,
-            intp->values[node->inputPins[5]->valueIndex].color);
+        AddDebugLine(intp, (DebugLine){
+                               .start = {intp->values[node->inputPins[1]->valueIndex].number, intp->values[node->inputPins[2]->valueIndex].number},
+                               .end = {intp->values[node->inputPins[3]->valueIndex].number, intp->values[node->inputPins[4]->valueIndex].number},
+                               .color = intp->values[node->inputPins[5]->valueIndex].color});
         break;
     }
 
@@ -1651,274 +2040,1056 @@ void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, Runtime
     {
         if (node->inputPins[1]->valueIndex != -1)
         {
-            if (intp->soundCount >= MAX_SOUNDS)
+            int soundHandle = GetBankedSound(&intp->sounds, &intp->arena, TextFormat("%s%c%s", intp->projectPath, PATH_SEPARATOR, GetValueString(intp, intp->values[node->inputPins[1]->valueIndex])));
+            if (soundHandle == SOUND_HANDLE_NONE)
             {
-                AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Maximum sounds reached{I104}"}, LOG_LEVEL_WARNING);
-                break;
+                AddToLogFromInterpreter(intp, "Invalid sound{I105}", LOG_LEVEL_WARNING);
             }
-            Sound temp = LoadSound(TextFormat("%s%c%s", intp->projectPath, PATH_SEPARATOR, intp->values[node->inputPins[1]->valueIndex].string));
-            if (temp.frameCount > 0)
+            else if (!PlayBankedSound(&intp->sounds, soundHandle))
             {
-                intp->sounds[intp->soundCount].sound = temp;
-                intp->sounds[intp->soundCount].timeLeft = (float)intp->sounds[intp->soundCount].sound.frameCount / intp->sounds[intp->soundCount].sound.stream.sampleRate;
-                PlaySound(intp->sounds[intp->soundCount].sound);
-                intp->soundCount++;
+                AddToLogFromInterpreter(intp, "Too many sounds playing{I104}", LOG_LEVEL_WARNING);
             }
-            else
+        }
+        break;
+    }
+    default:
+    {
+        break;
+    }
+    }
+}
+
+static int GetNextNodeIndexInChain(RuntimeGraphContext *graph, int lastNodeIndex, int outFlowPinIndexInNode)
+{
+    if (lastNodeIndex < 0 || lastNodeIndex >= graph->nodeCount)
+    {
+        return -1;
+    }
+
+    if (graph->nodes[lastNodeIndex].outputCount == 0 || graph->nodes[lastNodeIndex].outputPins[outFlowPinIndexInNode]->nextNodeIndex == -1)
+    {
+        return -1;
+    }
+
+    int currNodeIndex = graph->nodes[lastNodeIndex].outputPins[outFlowPinIndexInNode]->nextNodeIndex;
+    if (currNodeIndex < 0 || currNodeIndex >= graph->nodeCount)
+    {
+        return -1;
+    }
+
+    return currNodeIndex;
+}
+
+static bool PushContinuation(InterpreterContext *intp, Continuation continuation)
+{
+    if (intp->continuationCount >= intp->continuationCapacity)
+    {
+        int newCapacity = intp->continuationCapacity ? intp->continuationCapacity * 2 : INITIAL_CONTINUATION_CAPACITY;
+        Continuation *newContinuations = realloc(intp->continuations, sizeof(Continuation) * newCapacity);
+        if (!newContinuations)
+        {
+            AddToLogFromInterpreter(intp, "Out of memory: continuation stack{I214}", LOG_LEVEL_ERROR);
+            return false;
+        }
+        intp->continuations = newContinuations;
+        intp->continuationCapacity = newCapacity;
+    }
+
+    intp->continuations[intp->continuationCount++] = continuation;
+    return true;
+}
+
+// Returns true if the loop body should run once more
+static bool ShouldRunLoopBody(InterpreterContext *intp, RuntimeGraphContext *graph, Continuation *loop)
+{
+    if (!intp->values[graph->nodes[loop->nodeIndex].inputPins[1]->valueIndex].boolean)
+    {
+        return false;
+    }
+
+    if (loop->stepsLeft == 0)
+    {
+        if (intp->isInfiniteLoopProtectionOn)
+        {
+            AddToLogFromInterpreter(intp, "Possible infinite loop detected and exited! You can turn off infinite loop protection in settings{I210}", LOG_LEVEL_ERROR);
+            return false;
+        }
+        else
+        {
+            AddToLogFromInterpreter(intp, "Possible infinite loop detected! Infinite loop protection is off!{I101}", LOG_LEVEL_WARNING);
+        }
+    }
+    else
+    {
+        loop->stepsLeft--;
+    }
+
+    return true;
+}
+
+void InterpretStringOfNodes(int lastNodeIndex, InterpreterContext *intp, RuntimeGraphContext *graph, int outFlowPinIndexInNode)
+{
+    // Flow nodes push what is left to do on the continuation stack instead of recursing,
+    // so chain length is bounded by memory rather than by the C stack
+    int baseContinuationCount = intp->continuationCount;
+
+    while (true)
+    {
+        bool hasNextNode = false;
+
+        int currNodeIndex = GetNextNodeIndexInChain(graph, lastNodeIndex, outFlowPinIndexInNode);
+        if (currNodeIndex != -1)
+        {
+            RuntimeNode *node = &graph->nodes[currNodeIndex];
+
+#ifdef RAPID_HEADLESS
+            if (intp->nodeStats)
             {
-                UnloadSound(intp->sounds[intp->soundCount].sound);
-                AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Invalid sound{I105}"}, LOG_LEVEL_WARNING);
+                intp->nodeStats[currNodeIndex].executionCount++;
             }
+#endif
+
+            switch (node->type)
+            {
+            case NODE_BRANCH:
+            {
+                if (node->inputPins[1]->valueIndex != -1)
+                {
+                    outFlowPinIndexInNode = intp->values[node->inputPins[1]->valueIndex].boolean ? 0 : 1;
+                    lastNodeIndex = currNodeIndex;
+                    hasNextNode = true;
+                }
+                break;
+            }
+
+            case NODE_LOOP:
+            {
+                if (node->inputPins[1]->valueIndex == -1)
+                {
+                    hasNextNode = currNodeIndex != lastNodeIndex;
+                    lastNodeIndex = currNodeIndex;
+                    outFlowPinIndexInNode = 0;
+                    break;
+                }
+
+                if (!PushContinuation(intp, (Continuation){.type = CONTINUATION_LOOP, .nodeIndex = currNodeIndex, .lastNodeIndex = lastNodeIndex, .stepsLeft = MAX_ITERATIONS_BEFORE_ILP}))
+                {
+                    intp->continuationCount = baseContinuationCount;
+                    return;
+                }
+
+                if (ShouldRunLoopBody(intp, graph, &intp->continuations[intp->continuationCount - 1]))
+                {
+                    outFlowPinIndexInNode = 1;
+                    hasNextNode = true;
+                }
+                else
+                {
+                    intp->continuationCount--;
+                    outFlowPinIndexInNode = 0;
+                    hasNextNode = currNodeIndex != lastNodeIndex;
+                }
+                lastNodeIndex = currNodeIndex;
+                break;
+            }
+
+            case NODE_FLIP_FLOP:
+            {
+                if (!PushContinuation(intp, (Continuation){.type = CONTINUATION_FLIP_FLOP, .nodeIndex = currNodeIndex}))
+                {
+                    intp->continuationCount = baseContinuationCount;
+                    return;
+                }
+                outFlowPinIndexInNode = node->flipFlopState ? 0 : 1;
+                lastNodeIndex = currNodeIndex;
+                hasNextNode = true;
+                break;
+            }
+
+            case NODE_BREAK:
+            {
+                intp->shouldBreakFromLoop = true;
+                break;
+            }
+
+            case NODE_SEQUENCE:
+            {
+                if (!PushContinuation(intp, (Continuation){.type = CONTINUATION_SEQUENCE, .nodeIndex = currNodeIndex, .nextOutFlowPin = 1}))
+                {
+                    intp->continuationCount = baseContinuationCount;
+                    return;
+                }
+                outFlowPinIndexInNode = 0;
+                lastNodeIndex = currNodeIndex;
+                hasNextNode = true;
+                break;
+            }
+
+            default:
+            {
+#ifdef RAPID_HEADLESS
+                double startTime = intp->nodeStats ? GetTime() : 0.0;
+                ExecuteNode(intp, node);
+                if (intp->nodeStats)
+                {
+                    intp->nodeStats[currNodeIndex].seconds += GetTime() - startTime;
+                }
+#else
+                PROFILER_TIME_NODE(&intp->profiler, currNodeIndex, ExecuteNode(intp, node));
+#endif
+                hasNextNode = currNodeIndex != lastNodeIndex;
+                outFlowPinIndexInNode = 0;
+                lastNodeIndex = currNodeIndex;
+                break;
+            }
+            }
+        }
+
+        // The current chain has ended, resume the innermost flow node still waiting on it
+        while (!hasNextNode && intp->continuationCount > baseContinuationCount)
+        {
+            Continuation *continuation = &intp->continuations[intp->continuationCount - 1];
+
+            switch (continuation->type)
+            {
+            case CONTINUATION_SEQUENCE:
+            {
+                lastNodeIndex = continuation->nodeIndex;
+                outFlowPinIndexInNode = continuation->nextOutFlowPin;
+                if (continuation->nextOutFlowPin == 2)
+                {
+                    intp->continuationCount--;
+                }
+                else
+                {
+                    continuation->nextOutFlowPin++;
+                }
+                hasNextNode = true;
+                break;
+            }
+
+            case CONTINUATION_FLIP_FLOP:
+            {
+                graph->nodes[continuation->nodeIndex].flipFlopState = !graph->nodes[continuation->nodeIndex].flipFlopState;
+                intp->continuationCount--;
+                break;
+            }
+
+            case CONTINUATION_LOOP:
+            {
+                lastNodeIndex = continuation->nodeIndex;
+                if (intp->shouldBreakFromLoop)
+                {
+                    intp->shouldBreakFromLoop = false;
+                }
+                else if (ShouldRunLoopBody(intp, graph, continuation))
+                {
+                    outFlowPinIndexInNode = 1;
+                    hasNextNode = true;
+                    break;
+                }
+
+                intp->continuationCount--;
+                outFlowPinIndexInNode = 0;
+                hasNextNode = continuation->nodeIndex != continuation->lastNodeIndex;
+                break;
+            }
+            }
+        }
+
+        if (!hasNextNode)
+        {
+            return;
+        }
+    }
+}
+
+void RunEventChain(InterpreterContext *intp, RuntimeGraphContext *graph, int eventNodeIndex)
+{
+    if (intp->isBytecodeVMOn && intp->bytecode.isCompiled)
+    {
+        PROFILER_TIME_SECTION(&intp->profiler, PROFILER_SECTION_EVENTS, RunBytecode(intp, graph, eventNodeIndex));
+    }
+    else
+    {
+        PROFILER_TIME_SECTION(&intp->profiler, PROFILER_SECTION_EVENTS, InterpretStringOfNodes(eventNodeIndex, intp, graph, 0));
+    }
+}
+
+WorldHitbox *GetWorldHitbox(InterpreterContext *intp, int componentIndex)
+{
+    WorldHitbox *world = &intp->worldHitboxes[componentIndex];
+    if (world->isValid)
+    {
+        return world;
+    }
+
+    SceneComponent *component = &intp->components[componentIndex];
+    Hitbox *h = component->isSprite ? &component->sprite.hitbox : &component->prop.hitbox;
+    Vector2 pos = component->isSprite ? component->sprite.position : component->prop.position;
+    Vector2 size = component->isSprite ? (Vector2){component->sprite.width, component->sprite.height} : (Vector2){component->prop.width, component->prop.height};
+    Vector2 tex = component->isSprite ? (Vector2){component->sprite.texture.width, component->sprite.texture.height} : (Vector2){component->prop.texture.width, component->prop.texture.height};
+
+    float scaleX = size.x / tex.x;
+    float scaleY = size.y / tex.y;
+
+    world->vertexCount = h->type == HITBOX_POLY ? h->polygonHitbox.count : 0;
+
+    Vector2 min = {0, 0};
+    Vector2 max = {0, 0};
+    for (int i = 0; i < world->vertexCount; i++)
+    {
+        world->vertices[i].x = pos.x + h->offset.x * scaleX + h->polygonHitbox.vertices[i].x * scaleX;
+        world->vertices[i].y = pos.y + h->offset.y * scaleY + h->polygonHitbox.vertices[i].y * scaleY;
+
+        if (i == 0)
+        {
+            min = max = world->vertices[i];
+        }
+        else
+        {
+            min = (Vector2){fminf(min.x, world->vertices[i].x), fminf(min.y, world->vertices[i].y)};
+            max = (Vector2){fmaxf(max.x, world->vertices[i].x), fmaxf(max.y, world->vertices[i].y)};
+        }
+    }
+    world->bounds = (Rectangle){min.x, min.y, max.x - min.x, max.y - min.y};
+
+    world->isValid = true;
+    return world;
+}
+
+void DrawHitbox(Hitbox *h, WorldHitbox *world, Vector2 centerPos, Vector2 spriteSize, Vector2 texSize, Vector2 cameraOffset, Color color)
+{
+    float scaleX = spriteSize.x / texSize.x;
+    float scaleY = spriteSize.y / texSize.y;
+
+    switch (h->type)
+    {
+    case HITBOX_RECT:
+    {
+        Rectangle r = {
+            centerPos.x + h->offset.x * scaleX,
+            centerPos.y + h->offset.y * scaleY,
+            h->rectHitboxSize.x * scaleX,
+            h->rectHitboxSize.y * scaleY};
+        DrawRectangleLinesEx(r, 1, color);
+    }
+    break;
+
+    case HITBOX_CIRCLE:
+    {
+        Vector2 c = {
+            centerPos.x + h->offset.x * scaleX,
+            centerPos.y + h->offset.y * scaleY};
+        DrawCircleLines((int)c.x, (int)c.y, h->circleHitboxRadius * ((scaleX + scaleY) / 2), color);
+    }
+    break;
+
+    case HITBOX_POLY:
+    {
+        for (int i = 0; i < world->vertexCount; i++)
+        {
+            DrawLineV(Vector2Subtract(world->vertices[i], cameraOffset), Vector2Subtract(world->vertices[(i + 1) % world->vertexCount], cameraOffset), color);
+        }
+    }
+    break;
+
+    default:
+        break;
+    }
+}
+
+// Area a component can draw to in world space
+static Rectangle GetComponentDrawBounds(const SceneComponent *component)
+{
+    if (component->isSprite)
+    {
+        // Covers the sprite at any rotation around its center
+        float radius = sqrtf((float)component->sprite.width * component->sprite.width + (float)component->sprite.height * component->sprite.height) / 2.0f;
+        return (Rectangle){component->sprite.position.x - radius, component->sprite.position.y - radius, radius * 2, radius * 2};
+    }
+
+    if (component->prop.propType == PROP_CIRCLE)
+    {
+        float radius = fabsf(component->prop.width / 2.0f);
+        return (Rectangle){component->prop.position.x - radius, component->prop.position.y - radius, radius * 2, radius * 2};
+    }
+
+    Rectangle bounds = {component->prop.position.x, component->prop.position.y, component->prop.width, component->prop.height};
+    if (bounds.width < 0)
+    {
+        bounds.x += bounds.width;
+        bounds.width = -bounds.width;
+    }
+    if (bounds.height < 0)
+    {
+        bounds.y += bounds.height;
+        bounds.height = -bounds.height;
+    }
+    return bounds;
+}
+
+static int CompareRenderItems(const void *a, const void *b)
+{
+    const RenderItem *itemA = a;
+    const RenderItem *itemB = b;
+
+    if (itemA->layer != itemB->layer)
+    {
+        return itemA->layer < itemB->layer ? -1 : 1;
+    }
+    return (itemA->componentIndex > itemB->componentIndex) - (itemA->componentIndex < itemB->componentIndex);
+}
+
+// Moving a draw in front of draws it doesn't overlap leaves the frame the same, so later draws with the texture of
+// the current run are pulled into it when nothing they skip is under them
+static void GroupRenderItemsByTexture(RenderItem *items, int count)
+{
+    for (int i = 0; i + 1 < count; i++)
+    {
+        int runEnd = i + 1;
+        int end = count - runEnd > RENDER_BATCH_LOOKAHEAD ? runEnd + RENDER_BATCH_LOOKAHEAD : count;
+        for (int j = runEnd; j < end && items[j].layer == items[i].layer; j++)
+        {
+            if (items[j].textureID != items[i].textureID)
+            {
+                continue;
+            }
+
+            bool isBlocked = false;
+            for (int k = runEnd; k < j && !isBlocked; k++)
+            {
+                isBlocked = CheckCollisionRecs(items[j].bounds, items[k].bounds);
+            }
+            if (isBlocked)
+            {
+                continue;
+            }
+
+            RenderItem item = items[j];
+            memmove(&items[runEnd + 1], &items[runEnd], sizeof(RenderItem) * (j - runEnd));
+            items[runEnd++] = item;
+        }
+        i = runEnd - 1;
+    }
+}
+
+static void DrawComponent(InterpreterContext *intp, int componentIndex)
+{
+    const SceneComponent *component = &intp->components[componentIndex];
+    if (component->isSprite)
+    {
+        Vector2 position = component->sprite.position;
+        if (intp->isFixedTimestepOn)
+        {
+            position = Vector2Lerp(intp->previousPositions[componentIndex], position, intp->interpolationAlpha);
+        }
+
+        DrawTexturePro(
+            component->sprite.texture,
+            (Rectangle){0, 0, (float)component->sprite.texture.width, (float)component->sprite.texture.height},
+            (Rectangle){
+                position.x - intp->cameraOffset.x,
+                position.y - intp->cameraOffset.y,
+                (float)component->sprite.width,
+                (float)component->sprite.height},
+            (Vector2){component->sprite.width / 2.0f, component->sprite.height / 2.0f},
+            component->sprite.rotation,
+            WHITE);
+        return;
+    }
+
+    switch (component->prop.propType)
+    {
+    case PROP_TEXTURE:
+        break;
+    case PROP_RECTANGLE:
+        DrawRectangle(component->prop.position.x - intp->cameraOffset.x, component->prop.position.y - intp->cameraOffset.y, component->prop.width, component->prop.height, component->prop.color);
+        break;
+    case PROP_CIRCLE:
+        DrawCircle(component->prop.position.x - intp->cameraOffset.x, component->prop.position.y - intp->cameraOffset.y, component->prop.width / 2, component->prop.color);
+        break;
+    default:
+        AddToLogFromInterpreter(intp, "Out of bounds enum{O201}", LOG_LEVEL_ERROR);
+    }
+}
+
+static void DrawComponentHitbox(InterpreterContext *intp, int componentIndex)
+{
+    SceneComponent *component = &intp->components[componentIndex];
+    if (component->isSprite)
+    {
+        DrawHitbox(
+            &component->sprite.hitbox,
+            GetWorldHitbox(intp, componentIndex),
+            Vector2Subtract(component->sprite.position, intp->cameraOffset),
+            (Vector2){component->sprite.width, component->sprite.height},
+            (Vector2){component->sprite.texture.width, component->sprite.texture.height},
+            intp->cameraOffset,
+            RED);
+    }
+    else
+    {
+        DrawHitbox(
+            &component->prop.hitbox,
+            GetWorldHitbox(intp, componentIndex),
+            Vector2Subtract(component->prop.position, intp->cameraOffset),
+            (Vector2){component->prop.width, component->prop.height},
+            (Vector2){component->prop.width, component->prop.height},
+            intp->cameraOffset,
+            RED);
+    }
+}
+
+void DrawComponents(InterpreterContext *intp, Rectangle screenBoundary)
+{
+    ClearBackground(intp->backgroundColor);
+
+    Rectangle view = {screenBoundary.x + intp->cameraOffset.x, screenBoundary.y + intp->cameraOffset.y, screenBoundary.width, screenBoundary.height};
+
+    int itemCount = 0;
+    for (int i = 0; i < intp->componentCount; i++)
+    {
+        SceneComponent *component = &intp->components[i];
+        if (!component->isVisible)
+        {
+            continue;
+        }
+
+        Rectangle bounds = GetComponentDrawBounds(component);
+        if (component->isSprite && intp->isFixedTimestepOn)
+        {
+            // Drawn blended between the previous and current position
+            Vector2 position = Vector2Lerp(intp->previousPositions[i], component->sprite.position, intp->interpolationAlpha);
+            bounds.x += position.x - component->sprite.position.x;
+            bounds.y += position.y - component->sprite.position.y;
+        }
+        if (!CheckCollisionRecs(bounds, view))
+        {
+            continue;
+        }
+
+        intp->renderQueue[itemCount++] = (RenderItem){
+            .layer = component->isSprite ? component->sprite.layer : component->prop.layer,
+            .textureID = component->isSprite ? component->sprite.texture.id : 0,
+            .componentIndex = i,
+            .bounds = bounds};
+    }
+
+    qsort(intp->renderQueue, itemCount, sizeof(RenderItem), CompareRenderItems);
+    GroupRenderItemsByTexture(intp->renderQueue, itemCount);
+
+    for (int i = 0; i < itemCount; i++)
+    {
+        DrawComponent(intp, intp->renderQueue[i].componentIndex);
+    }
+
+    // Drawn after everything so line draws don't split the texture batches
+    if (intp->shouldShowHitboxes)
+    {
+        for (int i = 0; i < itemCount; i++)
+        {
+            DrawComponentHitbox(intp, intp->renderQueue[i].componentIndex);
+        }
+    }
+
+    for (int i = 0; i < intp->stepDebugLines.count; i++)
+    {
+        DebugLine *line = &intp->stepDebugLines.lines[i];
+        DrawLineV(line->start, line->end, line->color);
+    }
+    for (int i = 0; i < intp->frameDebugLines.count; i++)
+    {
+        DebugLine *line = &intp->frameDebugLines.lines[i];
+        DrawLineV(line->start, line->end, line->color);
+    }
+    intp->frameDebugLines.count = 0;
+}
+
+bool CheckCollisionPolyPoly(WorldHitbox *a, WorldHitbox *b)
+{
+    for (int i = 0; i < a->vertexCount; i++)
+    {
+        Vector2 a1 = a->vertices[i];
+        Vector2 a2 = a->vertices[(i + 1) % a->vertexCount];
+
+        for (int j = 0; j < b->vertexCount; j++)
+        {
+            if (CheckCollisionLines(a1, a2, b->vertices[j], b->vertices[(j + 1) % b->vertexCount], NULL))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool CheckCollisionPolyCircle(WorldHitbox *poly, Vector2 circlePos, float circleRadius)
+{
+    if (CheckCollisionPointPoly(circlePos, poly->vertices, poly->vertexCount))
+    {
+        return true;
+    }
+
+    for (int i = 0; i < poly->vertexCount; i++)
+    {
+        if (CheckCollisionPointCircle(poly->vertices[i], circlePos, circleRadius))
+        {
+            return true;
+        }
+    }
+
+    for (int i = 0; i < poly->vertexCount; i++)
+    {
+        Vector2 a = poly->vertices[i];
+        Vector2 b = poly->vertices[(i + 1) % poly->vertexCount];
+        if (CheckCollisionCircleLine(circlePos, circleRadius, a, b))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool CheckCollisionPolyRect(WorldHitbox *poly, Vector2 rectPos, Vector2 rectSize)
+{
+    Rectangle rect = {rectPos.x, rectPos.y, rectSize.x, rectSize.y};
+
+    for (int i = 0; i < poly->vertexCount; i++)
+    {
+        if (CheckCollisionPointRec(poly->vertices[i], rect))
+            return true;
+    }
+
+    Vector2 corners[4] = {
+        {rect.x, rect.y},
+        {rect.x + rect.width, rect.y},
+        {rect.x + rect.width, rect.y + rect.height},
+        {rect.x, rect.y + rect.height}};
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (CheckCollisionPointPoly(corners[i], poly->vertices, poly->vertexCount))
+            return true;
+    }
+
+    for (int i = 0; i < poly->vertexCount; i++)
+    {
+        Vector2 a = poly->vertices[i];
+        Vector2 b = poly->vertices[(i + 1) % poly->vertexCount];
+
+        Vector2 r[4][2] = {
+            {{rect.x, rect.y}, {rect.x + rect.width, rect.y}},
+            {{rect.x + rect.width, rect.y}, {rect.x + rect.width, rect.y + rect.height}},
+            {{rect.x + rect.width, rect.y + rect.height}, {rect.x, rect.y + rect.height}},
+            {{rect.x, rect.y + rect.height}, {rect.x, rect.y}}};
+
+        for (int j = 0; j < 4; j++)
+        {
+            if (CheckCollisionLines(a, b, r[j][0], r[j][1], NULL))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+// Inclusive overlap test that also accepts rectangles with negative size
+static bool DoBoundsOverlap(Rectangle a, Rectangle b)
+{
+    return fminf(a.x, a.x + a.width) <= fmaxf(b.x, b.x + b.width) && fminf(b.x, b.x + b.width) <= fmaxf(a.x, a.x + a.width) &&
+           fminf(a.y, a.y + a.height) <= fmaxf(b.y, b.y + b.height) && fminf(b.y, b.y + b.height) <= fmaxf(a.y, a.y + a.height);
+}
+
+static Rectangle GetComponentBoundingRect(SceneComponent *component)
+{
+    Hitbox *hitbox = component->isSprite ? &component->sprite.hitbox : &component->prop.hitbox;
+    Vector2 pos = component->isSprite ? component->sprite.position : component->prop.position;
+    Vector2 size = component->isSprite ? (Vector2){component->sprite.width, component->sprite.height} : (Vector2){component->prop.width, component->prop.height};
+
+    if (hitbox->type == HITBOX_RECT)
+    {
+        return (Rectangle){pos.x, pos.y, size.x, size.y};
+    }
+    return (Rectangle){pos.x - size.x / 2, pos.y - size.y / 2, size.x, size.y};
+}
+
+static CollisionGridRange GetCollisionGridRange(Rectangle rect)
+{
+    float minX = floorf(fminf(rect.x, rect.x + rect.width) / COLLISION_GRID_CELL_SIZE);
+    float minY = floorf(fminf(rect.y, rect.y + rect.height) / COLLISION_GRID_CELL_SIZE);
+    float maxX = floorf(fmaxf(rect.x, rect.x + rect.width) / COLLISION_GRID_CELL_SIZE);
+    float maxY = floorf(fmaxf(rect.y, rect.y + rect.height) / COLLISION_GRID_CELL_SIZE);
+
+    // Also catches NaN and positions too far out to fit a cell index
+    if (!((maxX - minX + 1) * (maxY - minY + 1) <= COLLISION_GRID_MAX_CELLS_PER_COMPONENT) || !(fabsf(minX) < 1e6f && fabsf(minY) < 1e6f))
+    {
+        return (CollisionGridRange){.isOversized = true};
+    }
+
+    return (CollisionGridRange){(int)minX, (int)minY, (int)maxX, (int)maxY, false};
+}
+
+static CollisionGridBucket *GetCollisionGridBucket(CollisionGrid *grid, int cellX, int cellY)
+{
+    unsigned int hash = ((unsigned int)cellX * 73856093u) ^ ((unsigned int)cellY * 19349663u);
+    return &grid->buckets[hash & (COLLISION_GRID_BUCKET_COUNT - 1)];
+}
+
+static bool AddToCollisionGridBucket(CollisionGridBucket *bucket, int componentIndex)
+{
+    if (bucket->count >= bucket->capacity)
+    {
+        int newCapacity = bucket->capacity ? bucket->capacity * 2 : 4;
+        int *newIndexes = realloc(bucket->componentIndexes, sizeof(int) * newCapacity);
+        if (!newIndexes)
+        {
+            return false;
+        }
+        bucket->componentIndexes = newIndexes;
+        bucket->capacity = newCapacity;
+    }
+
+    bucket->componentIndexes[bucket->count++] = componentIndex;
+    return true;
+}
+
+static void RemoveFromCollisionGridBucket(CollisionGridBucket *bucket, int componentIndex)
+{
+    for (int i = 0; i < bucket->count; i++)
+    {
+        if (bucket->componentIndexes[i] == componentIndex)
+        {
+            bucket->componentIndexes[i] = bucket->componentIndexes[--bucket->count];
+            return;
+        }
+    }
+}
+
+static bool InsertIntoCollisionGrid(CollisionGrid *grid, int componentIndex, CollisionGridRange range)
+{
+    if (range.isOversized)
+    {
+        return AddToCollisionGridBucket(&grid->oversized, componentIndex);
+    }
+
+    for (int y = range.minY; y <= range.maxY; y++)
+    {
+        for (int x = range.minX; x <= range.maxX; x++)
+        {
+            if (!AddToCollisionGridBucket(GetCollisionGridBucket(grid, x, y), componentIndex))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void RemoveFromCollisionGrid(CollisionGrid *grid, int componentIndex, CollisionGridRange range)
+{
+    if (range.isOversized)
+    {
+        RemoveFromCollisionGridBucket(&grid->oversized, componentIndex);
+        return;
+    }
+
+    for (int y = range.minY; y <= range.maxY; y++)
+    {
+        for (int x = range.minX; x <= range.maxX; x++)
+        {
+            RemoveFromCollisionGridBucket(GetCollisionGridBucket(grid, x, y), componentIndex);
+        }
+    }
+}
+
+void FreeCollisionGrid(CollisionGrid *grid)
+{
+    if (grid->buckets)
+    {
+        for (int i = 0; i < COLLISION_GRID_BUCKET_COUNT; i++)
+        {
+            free(grid->buckets[i].componentIndexes);
         }
-        break;
+        free(grid->buckets);
     }
-    default:
+    free(grid->oversized.componentIndexes);
+    free(grid->rangeByComponent);
+    free(grid->candidates);
+    free(grid->queryStampByComponent);
+
+    *grid = (CollisionGrid){0};
+}
+
+// On failure the grid is dropped and collision checks fall back to testing every component
+static void DisableCollisionGrid(InterpreterContext *intp)
+{
+    FreeCollisionGrid(&intp->collisionGrid);
+    intp->collisionGrid.hasFailed = true;
+    AddToLogFromInterpreter(intp, "Out of memory: collision grid, checking every component{I114}", LOG_LEVEL_WARNING);
+}
+
+static bool BuildCollisionGrid(InterpreterContext *intp)
+{
+    CollisionGrid *grid = &intp->collisionGrid;
+
+    grid->buckets = calloc(COLLISION_GRID_BUCKET_COUNT, sizeof(CollisionGridBucket));
+    grid->rangeByComponent = malloc(sizeof(CollisionGridRange) * intp->componentCapacity);
+    grid->candidates = malloc(sizeof(int) * intp->componentCapacity);
+    grid->queryStampByComponent = calloc(intp->componentCapacity, sizeof(int));
+    if (!grid->buckets || !grid->rangeByComponent || !grid->candidates || !grid->queryStampByComponent)
     {
-        break;
-    }
+        DisableCollisionGrid(intp);
+        return false;
     }
 
-    if (currNodeIndex != lastNodeIndex)
+    for (int i = 0; i < intp->componentCount; i++)
     {
-        InterpretStringOfNodes(currNodeIndex, intp, graph, 0);
+        grid->rangeByComponent[i] = GetCollisionGridRange(GetComponentBoundingRect(&intp->components[i]));
+        if (!InsertIntoCollisionGrid(grid, i, grid->rangeByComponent[i]))
+        {
+            DisableCollisionGrid(intp);
+            return false;
+        }
     }
+
+    grid->isBuilt = true;
+    return true;
 }
 
-void DrawHitbox(Hitbox *h, Vector2 centerPos, Vector2 spriteSize, Vector2 texSize, Color color)
+void UpdateComponentTransform(InterpreterContext *intp, int componentIndex)
 {
-    float scaleX = spriteSize.x / texSize.x;
-    float scaleY = spriteSize.y / texSize.y;
-
-    switch (h->type)
-    {
-    case HITBOX_RECT:
+    if (componentIndex < 0 || componentIndex >= intp->componentCount)
     {
-        Rectangle r = {
-            centerPos.x + h->offset.x * scaleX,
-            centerPos.y + h->offset.y * scaleY,
-            h->rectHitboxSize.x * scaleX,
-            h->rectHitboxSize.y * scaleY};
-        DrawRectangleLinesEx(r, 1, color);
+        return;
     }
-    break;
 
-    case HITBOX_CIRCLE:
+    intp->worldHitboxes[componentIndex].isValid = false;
+
+    CollisionGrid *grid = &intp->collisionGrid;
+    if (!grid->isBuilt)
     {
-        Vector2 c = {
-            centerPos.x + h->offset.x * scaleX,
-            centerPos.y + h->offset.y * scaleY};
-        DrawCircleLines((int)c.x, (int)c.y, h->circleHitboxRadius * ((scaleX + scaleY) / 2), color);
+        return;
     }
-    break;
 
-    case HITBOX_POLY:
+    CollisionGridRange newRange = GetCollisionGridRange(GetComponentBoundingRect(&intp->components[componentIndex]));
+    CollisionGridRange *range = &grid->rangeByComponent[componentIndex];
+    if (newRange.isOversized == range->isOversized && (newRange.isOversized || (newRange.minX == range->minX && newRange.minY == range->minY && newRange.maxX == range->maxX && newRange.maxY == range->maxY)))
     {
-        for (int i = 0; i < h->polygonHitbox.count; i++)
-        {
-            Vector2 p1 = {
-                centerPos.x + h->offset.x * scaleX + h->polygonHitbox.vertices[i].x * scaleX,
-                centerPos.y + h->offset.y * scaleY + h->polygonHitbox.vertices[i].y * scaleY};
-            Vector2 p2 = {
-                centerPos.x + h->offset.x * scaleX + h->polygonHitbox.vertices[(i + 1) % h->polygonHitbox.count].x * scaleX,
-                centerPos.y + h->offset.y * scaleY + h->polygonHitbox.vertices[(i + 1) % h->polygonHitbox.count].y * scaleY};
-            DrawLineV(p1, p2, color);
-        }
+        return;
     }
-    break;
 
-    default:
-        break;
+    RemoveFromCollisionGrid(grid, componentIndex, *range);
+    *range = newRange;
+    if (!InsertIntoCollisionGrid(grid, componentIndex, newRange))
+    {
+        DisableCollisionGrid(intp);
     }
 }
 
-void DrawComponents(InterpreterContext *intp)
+// Doubles every component array. The old arrays stay in the arena until the run ends, which at most doubles their
+// footprint, and once the pool is big enough for the game spawning never allocates again
+static bool GrowComponents(InterpreterContext *intp)
 {
-    ClearBackground(intp->backgroundColor);
+    int newCapacity = intp->componentCapacity * 2;
 
-    for (int i = 0; i < intp->componentCount; i++)
+    SceneComponent *components = ArenaCalloc(&intp->arena, newCapacity, sizeof(SceneComponent));
+    WorldHitbox *worldHitboxes = ArenaCalloc(&intp->arena, newCapacity, sizeof(WorldHitbox));
+    RenderItem *renderQueue = ArenaAlloc(&intp->arena, sizeof(RenderItem) * newCapacity);
+    Vector2 *previousPositions = ArenaCalloc(&intp->arena, newCapacity, sizeof(Vector2));
+    int *freeComponents = ArenaAlloc(&intp->arena, sizeof(int) * newCapacity);
+    if (!components || !worldHitboxes || !renderQueue || !previousPositions || !freeComponents)
+    {
+        return false;
+    }
+
+    memcpy(components, intp->components, sizeof(SceneComponent) * intp->componentCount);
+    memcpy(worldHitboxes, intp->worldHitboxes, sizeof(WorldHitbox) * intp->componentCount);
+    memcpy(previousPositions, intp->previousPositions, sizeof(Vector2) * intp->componentCount);
+    memcpy(freeComponents, intp->freeComponents, sizeof(int) * intp->freeComponentCount);
+
+    CollisionGrid *grid = &intp->collisionGrid;
+    if (grid->isBuilt)
     {
-        SceneComponent component = intp->components[i];
-        if (!component.isVisible)
+        CollisionGridRange *rangeByComponent = realloc(grid->rangeByComponent, sizeof(CollisionGridRange) * newCapacity);
+        if (rangeByComponent)
+            grid->rangeByComponent = rangeByComponent;
+        int *candidates = realloc(grid->candidates, sizeof(int) * newCapacity);
+        if (candidates)
+            grid->candidates = candidates;
+        int *queryStampByComponent = realloc(grid->queryStampByComponent, sizeof(int) * newCapacity);
+        if (queryStampByComponent)
         {
-            continue;
-        }
-        if (component.isSprite)
-        {
-            DrawTexturePro(
-                component.sprite.texture,
-                (Rectangle){0, 0, (float)component.sprite.texture.width, (float)component.sprite.texture.height},
-                (Rectangle){
-                    component.sprite.position.x - intp->cameraOffset.x,
-                    component.sprite.position.y - intp->cameraOffset.y,
-                    (float)component.sprite.width,
-                    (float)component.sprite.height},
-                (Vector2){component.sprite.width / 2.0f, component.sprite.height / 2.0f},
-                component.sprite.rotation,
-                WHITE);
-            if (intp->shouldShowHitboxes)
-            {
-                DrawHitbox(
-                    &component.sprite.hitbox,
-                    Vector2Subtract(component.sprite.position, intp->cameraOffset),
-                    (Vector2){component.sprite.width, component.sprite.height},
-                    (Vector2){component.sprite.texture.width, component.sprite.texture.height},
-                    RED);
-            }
-            continue;
+            grid->queryStampByComponent = queryStampByComponent;
+            memset(queryStampByComponent + intp->componentCapacity, 0, sizeof(int) * (newCapacity - intp->componentCapacity));
         }
-        else
+
+        if (!rangeByComponent || !candidates || !queryStampByComponent)
         {
-            switch (component.prop.propType)
-            {
-            case PROP_TEXTURE:
-                break;
-            case PROP_RECTANGLE:
-                DrawRectangle(component.prop.position.x - intp->cameraOffset.x, component.prop.position.y - intp->cameraOffset.y, component.prop.width, component.prop.height, component.prop.color);
-                break;
-            case PROP_CIRCLE:
-                DrawCircle(component.prop.position.x - intp->cameraOffset.x, component.prop.position.y - intp->cameraOffset.y, component.prop.width / 2, component.prop.color);
-                break;
-            default:
-                AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Out of bounds enum{O201}"}, LOG_LEVEL_ERROR);
-            }
-            if (intp->shouldShowHitboxes)
-            {
-                DrawHitbox(
-                    &component.prop.hitbox,
-                    Vector2Subtract(component.prop.position, intp->cameraOffset),
-                    (Vector2){component.prop.width, component.prop.height},
-                    (Vector2){component.prop.width, component.prop.height},
-                    RED);
-            }
+            DisableCollisionGrid(intp);
         }
     }
+
+    intp->components = components;
+    intp->worldHitboxes = worldHitboxes;
+    intp->renderQueue = renderQueue;
+    intp->previousPositions = previousPositions;
+    intp->freeComponents = freeComponents;
+    intp->componentCapacity = newCapacity;
+    return true;
 }
 
-bool CheckCollisionPolyPoly(Polygon *a, Vector2 aPos, Vector2 aSize, Vector2 aTexSize, Polygon *b, Vector2 bPos, Vector2 bSize, Vector2 bTexSize)
+int SpawnSpriteInstance(InterpreterContext *intp, int templateIndex)
 {
-    float scaleAX = aSize.x / aTexSize.x;
-    float scaleAY = aSize.y / aTexSize.y;
-    float scaleBX = bSize.x / bTexSize.x;
-    float scaleBY = bSize.y / bTexSize.y;
-
-    for (int i = 0; i < a->count; i++)
+    if (templateIndex < 0 || templateIndex >= intp->componentCount || !intp->components[templateIndex].isSprite)
     {
-        Vector2 a1 = {aPos.x + a->vertices[i].x * scaleAX,
-                      aPos.y + a->vertices[i].y * scaleAY};
-        Vector2 a2 = {aPos.x + a->vertices[(i + 1) % a->count].x * scaleAX,
-                      aPos.y + a->vertices[(i + 1) % a->count].y * scaleAY};
+        return -1;
+    }
 
-        for (int j = 0; j < b->count; j++)
+    int index;
+    bool isNewSlot = intp->freeComponentCount == 0;
+    if (isNewSlot)
+    {
+        if (intp->componentCount >= intp->componentCapacity && !GrowComponents(intp))
         {
-            Vector2 b1 = {bPos.x + b->vertices[j].x * scaleBX,
-                          bPos.y + b->vertices[j].y * scaleBY};
-            Vector2 b2 = {bPos.x + b->vertices[(j + 1) % b->count].x * scaleBX,
-                          bPos.y + b->vertices[(j + 1) % b->count].y * scaleBY};
-
-            if (CheckCollisionLines(a1, a2, b1, b2, NULL))
-            {
-                return true;
-            }
+            return -1;
         }
+        index = intp->componentCount++;
     }
-    return false;
-}
-
-bool CheckCollisionPolyCircle(Hitbox *h, Vector2 centerPos, Vector2 spriteSize, Vector2 texSize,
-                              Vector2 circlePos, float circleRadius)
-{
-    float scaleX = spriteSize.x / texSize.x;
-    float scaleY = spriteSize.y / texSize.y;
-
-    Vector2 transformed[64];
-    for (int i = 0; i < h->polygonHitbox.count; i++)
+    else
     {
-        transformed[i].x = centerPos.x + h->offset.x * scaleX + h->polygonHitbox.vertices[i].x * scaleX;
-        transformed[i].y = centerPos.y + h->offset.y * scaleY + h->polygonHitbox.vertices[i].y * scaleY;
+        index = intp->freeComponents[--intp->freeComponentCount];
     }
 
-    if (CheckCollisionPointPoly(circlePos, transformed, h->polygonHitbox.count))
+    SceneComponent *template = &intp->components[templateIndex];
+    SceneComponent *instance = &intp->components[index];
+
+    // The copy shares the template's texture and carries its own copy of the hitbox polygon
+    int generation = instance->generation;
+    *instance = *template;
+    instance->isVisible = true;
+    instance->isInstance = true;
+    instance->isFree = false;
+    instance->templateIndex = templateIndex;
+    instance->generation = generation;
+    instance->previousInstance = template->lastInstance;
+    instance->nextInstance = -1;
+    instance->lastInstance = -1;
+
+    if (template->lastInstance != -1)
     {
-        return true;
+        intp->components[template->lastInstance].nextInstance = index;
     }
+    template->lastInstance = index;
 
-    for (int i = 0; i < h->polygonHitbox.count; i++)
+    intp->previousPositions[index] = instance->sprite.position;
+
+    CollisionGrid *grid = &intp->collisionGrid;
+    if (isNewSlot && grid->isBuilt)
     {
-        if (CheckCollisionPointCircle(transformed[i], circlePos, circleRadius))
+        intp->worldHitboxes[index].isValid = false;
+        grid->rangeByComponent[index] = GetCollisionGridRange(GetComponentBoundingRect(instance));
+        if (!InsertIntoCollisionGrid(grid, index, grid->rangeByComponent[index]))
         {
-            return true;
+            DisableCollisionGrid(intp);
         }
     }
-
-    for (int i = 0; i < h->polygonHitbox.count; i++)
+    else
     {
-        Vector2 a = transformed[i];
-        Vector2 b = transformed[(i + 1) % h->polygonHitbox.count];
-        if (CheckCollisionCircleLine(circlePos, circleRadius, a, b))
-        {
-            return true;
-        }
+        UpdateComponentTransform(intp, index);
     }
 
-    return false;
+    return index;
 }
 
-bool CheckCollisionPolyRect(Polygon *poly, Vector2 polyPos, Vector2 polySize, Vector2 polyTexSize, Vector2 rectPos, Vector2 rectSize)
+int DestroySpriteInstance(InterpreterContext *intp, int componentIndex)
 {
-    float scaleX = polySize.x / polyTexSize.x;
-    float scaleY = polySize.y / polyTexSize.y;
-    Rectangle rect = {rectPos.x, rectPos.y, rectSize.x, rectSize.y};
+    SceneComponent *instance = &intp->components[componentIndex];
+    SceneComponent *template = &intp->components[instance->templateIndex];
 
-    for (int i = 0; i < poly->count; i++)
+    if (instance->previousInstance != -1)
     {
-        Vector2 p = {
-            polyPos.x + poly->vertices[i].x * scaleX,
-            polyPos.y + poly->vertices[i].y * scaleY};
-        if (CheckCollisionPointRec(p, rect))
-            return true;
+        intp->components[instance->previousInstance].nextInstance = instance->nextInstance;
+    }
+    if (instance->nextInstance != -1)
+    {
+        intp->components[instance->nextInstance].previousInstance = instance->previousInstance;
+    }
+    else
+    {
+        template->lastInstance = instance->previousInstance;
     }
 
-    Vector2 corners[4] = {
-        {rect.x, rect.y},
-        {rect.x + rect.width, rect.y},
-        {rect.x + rect.width, rect.y + rect.height},
-        {rect.x, rect.y + rect.height}};
+    // Stays in the collision grid where it was, free components are skipped and it moves when reused
+    instance->isVisible = false;
+    instance->isFree = true;
+    instance->generation++;
+    intp->freeComponents[intp->freeComponentCount++] = componentIndex;
+
+    return template->lastInstance != -1 ? template->lastInstance : instance->templateIndex;
+}
+
+static int CompareComponentIndexes(const void *a, const void *b)
+{
+    return *(const int *)a - *(const int *)b;
+}
 
-    Vector2 transformed[64];
-    for (int i = 0; i < poly->count; i++)
+static void AddCollisionCandidates(CollisionGrid *grid, CollisionGridBucket *bucket, int *candidateCount)
+{
+    for (int i = 0; i < bucket->count; i++)
     {
-        transformed[i].x = polyPos.x + poly->vertices[i].x * scaleX;
-        transformed[i].y = polyPos.y + poly->vertices[i].y * scaleY;
+        int componentIndex = bucket->componentIndexes[i];
+        if (grid->queryStampByComponent[componentIndex] != grid->queryStamp)
+        {
+            grid->queryStampByComponent[componentIndex] = grid->queryStamp;
+            grid->candidates[(*candidateCount)++] = componentIndex;
+        }
     }
+}
 
-    for (int i = 0; i < 4; i++)
+// Fills grid->candidates with the components in cells overlapping rect, in index order so results
+// match a full scan. Returns -1 if the grid is unavailable.
+static int GetCollisionCandidates(InterpreterContext *intp, Rectangle rect)
+{
+    CollisionGrid *grid = &intp->collisionGrid;
+    if (!grid->isBuilt && (grid->hasFailed || !BuildCollisionGrid(intp)))
     {
-        if (CheckCollisionPointPoly(corners[i], transformed, poly->count))
-            return true;
+        return -1;
     }
 
-    for (int i = 0; i < poly->count; i++)
+    if (grid->queryStamp == INT_MAX)
     {
-        Vector2 a = transformed[i];
-        Vector2 b = transformed[(i + 1) % poly->count];
+        memset(grid->queryStampByComponent, 0, sizeof(int) * intp->componentCount);
+        grid->queryStamp = 0;
+    }
+    grid->queryStamp++;
 
-        Vector2 r[4][2] = {
-            {{rect.x, rect.y}, {rect.x + rect.width, rect.y}},
-            {{rect.x + rect.width, rect.y}, {rect.x + rect.width, rect.y + rect.height}},
-            {{rect.x + rect.width, rect.y + rect.height}, {rect.x, rect.y + rect.height}},
-            {{rect.x, rect.y + rect.height}, {rect.x, rect.y}}};
+    CollisionGridRange range = GetCollisionGridRange(rect);
+    if (range.isOversized)
+    {
+        for (int i = 0; i < intp->componentCount; i++)
+        {
+            grid->candidates[i] = i;
+        }
+        return intp->componentCount;
+    }
 
-        for (int j = 0; j < 4; j++)
+    int candidateCount = 0;
+    AddCollisionCandidates(grid, &grid->oversized, &candidateCount);
+    for (int y = range.minY; y <= range.maxY; y++)
+    {
+        for (int x = range.minX; x <= range.maxX; x++)
         {
-            if (CheckCollisionLines(a, b, r[j][0], r[j][1], NULL))
-                return true;
+            AddCollisionCandidates(grid, GetCollisionGridBucket(grid, x, y), &candidateCount);
         }
     }
 
-    return false;
+    qsort(grid->candidates, candidateCount, sizeof(int), CompareComponentIndexes);
+    return candidateCount;
 }
 
-CollisionResult CheckCollisions(InterpreterContext *intp, int index)
+static CollisionResult FindCollision(InterpreterContext *intp, int index)
 {
     if (index < 0 || index >= intp->componentCount)
     {
@@ -1931,24 +3102,39 @@ CollisionResult CheckCollisions(InterpreterContext *intp, int index)
     Hitbox *hitA = a->isSprite ? &a->sprite.hitbox : &a->prop.hitbox;
     Vector2 posA = a->isSprite ? a->sprite.position : a->prop.position;
     Vector2 sizeA = a->isSprite ? (Vector2){a->sprite.width, a->sprite.height} : (Vector2){a->prop.width, a->prop.height};
-    Vector2 texA = a->isSprite ? (Vector2){a->sprite.texture.width, a->sprite.texture.height} : (Vector2){a->prop.texture.width, a->prop.texture.height};
 
     Rectangle aSimplifiedHitbox = (Rectangle){posA.x - sizeA.x / 2, posA.y - sizeA.y / 2, sizeA.x, sizeA.y};
 
     if (hitA->type != HITBOX_POLY)
     {
-        AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Invalid sprite hitbox{I106}"}, LOG_LEVEL_WARNING);
+        AddToLogFromInterpreter(intp, "Invalid sprite hitbox{I106}", LOG_LEVEL_WARNING);
         return COLLISION_RESULT_NONE;
     }
 
-    for (int j = 0; j < intp->componentCount; j++)
+    WorldHitbox *worldA = GetWorldHitbox(intp, index);
+
+    // Without the grid every component is a candidate
+    int candidateCount = GetCollisionCandidates(intp, aSimplifiedHitbox);
+    bool isUsingGrid = candidateCount != -1;
+    if (!isUsingGrid)
+    {
+        candidateCount = intp->componentCount;
+    }
+
+    for (int c = 0; c < candidateCount; c++)
     {
+        int j = isUsingGrid ? intp->collisionGrid.candidates[c] : c;
         if (j == index)
         {
             continue;
         }
 
         SceneComponent *b = &intp->components[j];
+        if (b->isFree)
+        {
+            continue;
+        }
+
         int layerB = b->isSprite ? b->sprite.layer : b->prop.layer;
 
         bool aBlocks = (layerA == COMPONENT_LAYER_BLOCKING || layerA == COMPONENT_LAYER_COLLISION_EVENTS_AND_BLOCKING);
@@ -1967,23 +3153,7 @@ CollisionResult CheckCollisions(InterpreterContext *intp, int index)
         Vector2 sizeB = b->isSprite ? (Vector2){b->sprite.width, b->sprite.height} : (Vector2){b->prop.width, b->prop.height};
         Vector2 texB = b->isSprite ? (Vector2){b->sprite.texture.width, b->sprite.texture.height} : (Vector2){b->prop.texture.width, b->prop.texture.height};
 
-        Rectangle bSimplifiedHitbox;
-
-        switch (hitB->type)
-        {
-        case HITBOX_RECT:
-            bSimplifiedHitbox = (Rectangle){posB.x, posB.y, sizeB.x, sizeB.y};
-            break;
-        case HITBOX_CIRCLE:
-            bSimplifiedHitbox = (Rectangle){posB.x - sizeB.x / 2, posB.y - sizeB.y / 2, sizeB.x, sizeB.y};
-            break;
-        case HITBOX_POLY:
-            bSimplifiedHitbox = (Rectangle){posB.x - sizeB.x / 2, posB.y - sizeB.y / 2, sizeB.x, sizeB.y};
-            break;
-        default:
-            AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Out of bounds enum{O201}"}, LOG_LEVEL_WARNING);
-            break;
-        }
+        Rectangle bSimplifiedHitbox = GetComponentBoundingRect(b);
 
         if (!CheckCollisionRecs(aSimplifiedHitbox, bSimplifiedHitbox))
         {
@@ -1995,8 +3165,11 @@ CollisionResult CheckCollisions(InterpreterContext *intp, int index)
         switch (hitB->type)
         {
         case HITBOX_POLY:
-            collided = CheckCollisionPolyPoly(&hitA->polygonHitbox, posA, sizeA, texA, &hitB->polygonHitbox, posB, sizeB, texB);
+        {
+            WorldHitbox *worldB = GetWorldHitbox(intp, j);
+            collided = DoBoundsOverlap(worldA->bounds, worldB->bounds) && CheckCollisionPolyPoly(worldA, worldB);
             break;
+        }
         case HITBOX_CIRCLE:
         {
             float scaleX = texB.x != 0 ? sizeB.x / texB.x : 1.0f;
@@ -2006,14 +3179,16 @@ CollisionResult CheckCollisions(InterpreterContext *intp, int index)
                 posB.x + hitB->offset.x * scaleX,
                 posB.y + hitB->offset.y * scaleY};
 
-            collided = CheckCollisionPolyCircle(hitA, posA, sizeA, texA, posB, hitB->circleHitboxRadius * ((scaleX + scaleY) / 2));
+            float radius = hitB->circleHitboxRadius * ((scaleX + scaleY) / 2);
+            Rectangle circleBounds = {posB.x - fabsf(radius), posB.y - fabsf(radius), 2 * fabsf(radius), 2 * fabsf(radius)};
+            collided = DoBoundsOverlap(worldA->bounds, circleBounds) && CheckCollisionPolyCircle(worldA, posB, radius);
             break;
         }
         case HITBOX_RECT:
-            collided = CheckCollisionPolyRect(&hitA->polygonHitbox, posA, sizeA, texA, posB, hitB->rectHitboxSize);
+            collided = DoBoundsOverlap(worldA->bounds, (Rectangle){posB.x, posB.y, hitB->rectHitboxSize.x, hitB->rectHitboxSize.y}) && CheckCollisionPolyRect(worldA, posB, hitB->rectHitboxSize);
             break;
         default:
-            AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "Out of bounds enum{O201}"}, LOG_LEVEL_WARNING);
+            AddToLogFromInterpreter(intp, "Out of bounds enum{O201}", LOG_LEVEL_WARNING);
             break;
         }
 
@@ -2040,40 +3215,55 @@ CollisionResult CheckCollisions(InterpreterContext *intp, int index)
     return COLLISION_RESULT_NONE;
 }
 
+CollisionResult CheckCollisions(InterpreterContext *intp, int index)
+{
+    CollisionResult result;
+    PROFILER_TIME_SECTION(&intp->profiler, PROFILER_SECTION_COLLISIONS, result = FindCollision(intp, index));
+    return result;
+}
+
 void HandleForces(InterpreterContext *intp)
 {
+    ForceStore *forces = &intp->forces;
+    float deltaTime = intp->deltaTime;
+
+    // Kept apart from the movement below, which has to check collisions one force at a time
+    for (int i = 0; i < forces->count; i++)
+    {
+        forces->durations[i] -= deltaTime;
+    }
+
     int i = 0;
-    while (i < intp->forceCount)
+    while (i < forces->count)
     {
-        Force *f = &intp->forces[i];
-        Vector2 *pos = &intp->components[f->componentIndex].sprite.position;
+        int componentIndex = forces->componentIndexes[i];
+        if (intp->components[componentIndex].generation != forces->generations[i])
+        {
+            // The sprite was destroyed, and its slot maybe already reused
+            RemoveForce(forces, i);
+            continue;
+        }
 
-        float speed = f->pixelsPerSecond;
-        float angle = f->angle * (PI / 180.0f);
-        float vx = cosf(angle) * speed;
-        float vy = -sinf(angle) * speed;
-        float deltaTime = GetFrameTime();
+        Vector2 *pos = &intp->components[componentIndex].sprite.position;
 
         Vector2 prevPos = *pos;
 
-        pos->x += vx * deltaTime;
-        pos->y += vy * deltaTime;
-
-        f->duration -= deltaTime;
+        pos->x += forces->velocitiesX[i] * deltaTime;
+        pos->y += forces->velocitiesY[i] * deltaTime;
+        intp->worldHitboxes[componentIndex].isValid = false;
 
-        CollisionResult result = CheckCollisions(intp, f->componentIndex);
+        CollisionResult result = CheckCollisions(intp, componentIndex);
         if (result == COLLISION_RESULT_BLOCKING || result == COLLISION_RESULT_EVENT_AND_BLOCKING)
         {
             *pos = prevPos;
         }
 
-        if (f->duration <= 0)
+        UpdateComponentTransform(intp, componentIndex);
+
+        if (forces->durations[i] <= 0)
         {
-            for (int j = i; j < intp->forceCount - 1; j++)
-            {
-                intp->forces[j] = intp->forces[j + 1];
-            }
-            intp->forceCount--;
+            // The last force moves into i and still has to be handled
+            RemoveForce(forces, i);
             continue;
         }
 
@@ -2083,32 +3273,59 @@ void HandleForces(InterpreterContext *intp)
 
 void HandleSounds(InterpreterContext *intp)
 {
-    float frameTime = GetFrameTime();
-    for (int i = 0; i < intp->soundCount; i++)
-    {
-        intp->sounds[i].timeLeft -= frameTime;
-        if (intp->sounds[i].timeLeft <= 0)
-        {
-            UnloadSound(intp->sounds[i].sound);
-            for (int j = i; j < intp->soundCount - 1; j++)
-            {
-                intp->sounds[j] = intp->sounds[j + 1];
-            }
-            intp->soundCount--;
-            i--;
-        }
-        if (intp->hasSoundOnChanged)
-        {
-            float volume = intp->isSoundOn ? 1.0f : 0.0f;
-            SetSoundVolume(intp->sounds[i].sound, volume);
-        }
-    }
+    UpdateSoundVoices(&intp->sounds, GetFrameTime());
+
     if (intp->hasSoundOnChanged)
     {
+        SetSoundBankVolume(&intp->sounds, intp->isSoundOn ? 1.0f : 0.0f);
         intp->hasSoundOnChanged = false;
     }
 }
 
+static void HandleCameraShake(InterpreterContext *intp)
+{
+    static Vector2 lastShake = {0, 0};
+    if (intp->shakeCameraTimeRemaining > 0.0f)
+    {
+        intp->shakeCameraTimeRemaining -= intp->deltaTime;
+
+        intp->cameraOffset.x -= lastShake.x;
+        intp->cameraOffset.y -= lastShake.y;
+
+        lastShake.x = GetRandomValue(-intp->shakeCameraIntensity, intp->shakeCameraIntensity);
+        lastShake.y = GetRandomValue(-intp->shakeCameraIntensity, intp->shakeCameraIntensity);
+
+        intp->cameraOffset.x += lastShake.x;
+        intp->cameraOffset.y += lastShake.y;
+    }
+    else if (lastShake.x != 0 || lastShake.y != 0)
+    {
+        intp->cameraOffset.x -= lastShake.x;
+        intp->cameraOffset.y -= lastShake.y;
+
+        lastShake.x = 0;
+        lastShake.y = 0;
+    }
+}
+
+// Everything that advances the game by intp->deltaTime. Input events stay once per rendered frame
+// so a key press never fires twice or gets lost between steps
+static void RunSimulationStep(InterpreterContext *intp, RuntimeGraphContext *graph)
+{
+    // Only the last step of a frame is drawn, so steps never draw a line twice or skip it between frames
+    intp->stepDebugLines.count = 0;
+    intp->isRunningStep = true;
+    for (int i = 0; i < intp->tickNodeIndexesCount; i++)
+    {
+        RunEventChain(intp, graph, intp->tickNodeIndexes[i]);
+    }
+    intp->isRunningStep = false;
+
+    PROFILER_TIME_SECTION(&intp->profiler, PROFILER_SECTION_FORCES, HandleForces(intp));
+
+    HandleCameraShake(intp);
+}
+
 bool HandleGameScreen(InterpreterContext *intp, RuntimeGraphContext *graph, Vector2 mousePos, Rectangle screenBoundary)
 {
     ClearBackground(BLACK);
@@ -2120,7 +3337,7 @@ bool HandleGameScreen(InterpreterContext *intp, RuntimeGraphContext *graph, Vect
 
     if (intp->isPaused)
     {
-        DrawComponents(intp);
+        DrawComponents(intp, screenBoundary);
         DrawRectangleRec(screenBoundary, COLOR_INTP_PAUSE_BLUR);
         return true;
     }
@@ -2129,13 +3346,13 @@ bool HandleGameScreen(InterpreterContext *intp, RuntimeGraphContext *graph, Vect
 
     if (intp->isFirstFrame)
     {
-        intp->onButtonNodeIndexes = malloc(sizeof(int) * graph->nodeCount);
+        intp->onButtonNodeIndexes = ArenaAlloc(&intp->arena, sizeof(int) * graph->nodeCount);
         for (int i = 0; i < graph->nodeCount; i++)
         {
             switch (graph->nodes[i].type)
             {
             case NODE_EVENT_START:
-                InterpretStringOfNodes(i, intp, graph, 0);
+                RunEventChain(intp, graph, i);
                 break;
             case NODE_EVENT_TICK:
                 if (intp->tickNodeIndexesCount < MAX_TICK_NODES)
@@ -2145,13 +3362,15 @@ bool HandleGameScreen(InterpreterContext *intp, RuntimeGraphContext *graph, Vect
                 }
                 break;
             case NODE_EVENT_ON_BUTTON:
-                intp->onButtonNodeIndexes[intp->onButtonNodeIndexesCount++] = i;
+                if (intp->onButtonNodeIndexes)
+                {
+                    intp->onButtonNodeIndexes[intp->onButtonNodeIndexesCount++] = i;
+                }
                 break;
             default:
                 break;
             }
         }
-        intp->onButtonNodeIndexes = realloc(intp->onButtonNodeIndexes, sizeof(int) * intp->onButtonNodeIndexesCount);
 
         intp->isFirstFrame = false;
     }
@@ -2190,60 +3409,58 @@ bool HandleGameScreen(InterpreterContext *intp, RuntimeGraphContext *graph, Vect
 
         if (triggered)
         {
-            InterpretStringOfNodes(nodeIndex, intp, graph, 0);
+            RunEventChain(intp, graph, nodeIndex);
         }
     }
 
     if (intp->tickNodeIndexesCount == 0)
     {
-        AddToLogFromInterpreter(intp, (Value){.type = VAL_STRING, .string = "No tick node found{I211}"}, LOG_LEVEL_ERROR);
+        AddToLogFromInterpreter(intp, "No tick node found{I211}", LOG_LEVEL_ERROR);
         return false;
     }
-    else
+
+    if (intp->isFixedTimestepOn)
     {
-        for (int i = 0; i < intp->tickNodeIndexesCount; i++)
+        float step = 1.0f / FIXED_TICK_RATE;
+
+        intp->tickAccumulator += GetFrameTime();
+        if (intp->tickAccumulator > step * MAX_FIXED_TICKS_PER_FRAME)
         {
-            InterpretStringOfNodes(intp->tickNodeIndexes[i], intp, graph, 0);
+            intp->tickAccumulator = step * MAX_FIXED_TICKS_PER_FRAME;
         }
-    }
-
-    HandleForces(intp);
-
-    HandleSounds(intp);
-
-    DrawComponents(intp);
 
-    for (int i = 0; i < intp->valueCount; i++)
-    {
-        if (intp->values[i].type == VAL_SPRITE)
+        while (intp->tickAccumulator >= step)
         {
-            intp->components[intp->values[i].componentIndex].sprite.isVisible = intp->components[intp->values[i].componentIndex].isVisible;
-            intp->values[i].sprite = intp->components[intp->values[i].componentIndex].sprite;
+            for (int i = 0; i < intp->componentCount; i++)
+            {
+                if (intp->components[i].isSprite)
+                {
+                    intp->previousPositions[i] = intp->components[i].sprite.position;
+                }
+            }
+
+            intp->deltaTime = step;
+            RunSimulationStep(intp, graph);
+            intp->tickAccumulator -= step;
         }
-    }
 
-    static Vector2 lastShake = {0, 0};
-    if (intp->shakeCameraTimeRemaining > 0.0f)
+        intp->interpolationAlpha = intp->tickAccumulator / step;
+    }
+    else
     {
-        intp->shakeCameraTimeRemaining -= GetFrameTime();
-
-        intp->cameraOffset.x -= lastShake.x;
-        intp->cameraOffset.y -= lastShake.y;
+        intp->deltaTime = GetFrameTime();
+        RunSimulationStep(intp, graph);
+        intp->interpolationAlpha = 1.0f;
+    }
 
-        lastShake.x = GetRandomValue(-intp->shakeCameraIntensity, intp->shakeCameraIntensity);
-        lastShake.y = GetRandomValue(-intp->shakeCameraIntensity, intp->shakeCameraIntensity);
+    // Sounds play in real time whatever the simulation rate
+    PROFILER_TIME_SECTION(&intp->profiler, PROFILER_SECTION_SOUNDS, HandleSounds(intp));
 
-        intp->cameraOffset.x += lastShake.x;
-        intp->cameraOffset.y += lastShake.y;
-    }
-    else if (lastShake.x != 0 || lastShake.y != 0)
-    {
-        intp->cameraOffset.x -= lastShake.x;
-        intp->cameraOffset.y -= lastShake.y;
+    PROFILER_TIME_SECTION(&intp->profiler, PROFILER_SECTION_DRAW, DrawComponents(intp, screenBoundary));
 
-        lastShake.x = 0;
-        lastShake.y = 0;
-    }
+#ifdef RAPID_PROFILER
+    EndProfilerFrame(&intp->profiler, GetFrameTime());
+#endif
 
     return true;
 }
\ No newline at end of file
@@ -10,15 +10,30 @@
 #include "raylib.h"
 #include "Nodes.h"
 #include "definitions.h"
+#include "Bytecode.h"
+#include "Arena.h"
+#include "StringTable.h"
+#include "TextureCache.h"
+#include "SoundBank.h"
+#include "AssetPreload.h"
+#include "Profiler.h"
 
 #define MAX_LINKS_PER_PIN 16
 
-#define MAX_SOUNDS 32
 #define MAX_TICK_NODES 10
 #define MIN_ZOOM 0.5f
 
 #define MAX_ITERATIONS_BEFORE_ILP 1000
 
+// Simulation steps per second when the fixed timestep is on
+#define FIXED_TICK_RATE 120
+// Steps dropped beyond this after a long frame, so a slow frame can't snowball into slower ones
+#define MAX_FIXED_TICKS_PER_FRAME 8
+
+#define INITIAL_CONTINUATION_CAPACITY 64
+
+#define INITIAL_DEBUG_LINE_CAPACITY 32
+
 typedef struct RuntimePin
 {
     int id;
@@ -91,10 +106,9 @@ typedef struct
     };
 } Hitbox;
 
+// Visibility is kept on the SceneComponent
 typedef struct
 {
-    bool isVisible;
-
     Vector2 position;
     int width;
     int height;
@@ -103,7 +117,9 @@ typedef struct
 
     Hitbox hitbox;
 
+    // Copy of the cached texture, textureHandle is the reference held in intp->textures
     Texture2D texture;
+    int textureHandle;
 } Sprite;
 
 typedef enum
@@ -133,6 +149,18 @@ typedef struct
     bool isVisible;
     bool isSprite;
 
+    // Spawned copy of the sprite built from templateIndex, returned to the pool when destroyed
+    bool isInstance;
+    bool isFree;
+    int templateIndex;
+    // Bumped every time the slot goes back to the pool, so anything holding on to an old instance can tell
+    int generation;
+
+    // Live instances of a template, newest last. lastInstance is only used on templates, -1 without instances
+    int previousInstance;
+    int nextInstance;
+    int lastInstance;
+
     union
     {
         Sprite sprite;
@@ -140,54 +168,175 @@ typedef struct
     };
 } SceneComponent;
 
+// Kept to 16 bytes so the value array stays cache friendly, names are in intp->valueNames
+// and sprite state in intp->components
 typedef struct
 {
-    char *name;
     ValueType type;
     bool isVariable;
     union
     {
         float number;
         bool boolean;
-        char *string;
+        // ID in intp->strings. Only owned strings change, so copies into variables go through CopyString
+        int stringID;
         Vector2 vector;
         Color color;
-        Sprite sprite;
+        // Handle of a sprite value, index in intp->components or -1 until a sprite is bound
+        int componentIndex;
     };
-    int componentIndex;
 } Value;
 
+#define FORCE_STORE_INITIAL_CAPACITY 64
+
+// Active forces as parallel arrays, removed by moving the last force into the gap
 typedef struct
 {
-    int id;
+    // Runtime node that started each force
+    int *nodeIndexes;
+    int *componentIndexes;
+    // Generation of the component when the force started, the force ends once the component is despawned
+    int *generations;
+    // Pixels per second, worked out once when the force starts
+    float *velocitiesX;
+    float *velocitiesY;
+    float *durations;
+    int count;
+    int capacity;
+
+    // Open addressing index from node and component to force, -1 when empty
+    int *slots;
+    int slotCapacity;
+} ForceStore;
+
+// Polygon hitbox of a component in world space, recomputed only after its position, size or texture changes
+typedef struct
+{
+    Vector2 vertices[MAX_POLYGON_VERTICES];
+    int vertexCount;
+    Rectangle bounds;
+    bool isValid;
+} WorldHitbox;
+
+// One visible component of the frame. Drawn in layer and then component order, except that a draw is moved up
+// next to an earlier one with the same texture when it overlaps none of the draws it skips, so raylib merges
+// them into one batch without changing what ends up on top
+typedef struct
+{
+    int layer;
+    unsigned int textureID;
     int componentIndex;
-    int pixelsPerSecond;
-    int angle;
-    float duration;
-} Force;
+    // Area drawn to in world space
+    Rectangle bounds;
+} RenderItem;
+
+// How many draws ahead a texture run looks for more draws to pull in
+#define RENDER_BATCH_LOOKAHEAD 32
+
+#define COLLISION_GRID_CELL_SIZE 128.0f
+#define COLLISION_GRID_BUCKET_COUNT 1024
+#define COLLISION_GRID_MAX_CELLS_PER_COMPONENT 64
 
 typedef struct
 {
-    Sound sound;
-    float timeLeft;
-} ActiveSound;
+    int *componentIndexes;
+    int count;
+    int capacity;
+} CollisionGridBucket;
+
+// Cells covered by a component, components covering too many cells are kept in the oversized bucket
+typedef struct
+{
+    int minX;
+    int minY;
+    int maxX;
+    int maxY;
+    bool isOversized;
+} CollisionGridRange;
+
+// Spatial hash over intp->components, built on the first collision check of a run
+typedef struct
+{
+    CollisionGridBucket *buckets;
+    CollisionGridBucket oversized;
+    CollisionGridRange *rangeByComponent;
+
+    int *candidates;
+    int *queryStampByComponent;
+    int queryStamp;
+
+    bool isBuilt;
+    bool hasFailed;
+} CollisionGrid;
+
+#ifdef RAPID_HEADLESS
+typedef struct
+{
+    double seconds;
+    long long executionCount;
+} NodeStats;
+#endif
+
+typedef enum
+{
+    CONTINUATION_SEQUENCE,
+    CONTINUATION_FLIP_FLOP,
+    CONTINUATION_LOOP
+} ContinuationType;
+
+// Work left over once the chain started by a flow node has finished
+typedef struct
+{
+    ContinuationType type;
+    int nodeIndex;
+    int lastNodeIndex;
+    int nextOutFlowPin;
+    int stepsLeft;
+} Continuation;
+
+typedef struct
+{
+    Vector2 start;
+    Vector2 end;
+    Color color;
+} DebugLine;
+
+typedef struct
+{
+    DebugLine *lines;
+    int count;
+    int capacity;
+} DebugLineList;
 
 typedef struct
 {
     Value *values;
+    // Parallel to values, only read by the variables panel and when binding sprites
+    char **valueNames;
     int valueCount;
 
     int *varIndexes;
     int varCount;
 
-    Force *forces;
-    int forceCount;
+    ForceStore forces;
 
     SceneComponent *components;
+    WorldHitbox *worldHitboxes;
+    // Room for every component, refilled by DrawComponents each frame
+    RenderItem *renderQueue;
+    // Sprite positions before the current fixed step, drawn blended towards the current ones
+    Vector2 *previousPositions;
     int componentCount;
+    // Length of the component arrays above, grows when spawning runs out of pooled instances
+    int componentCapacity;
+    // Slots of destroyed instances, reused by the next spawn
+    int *freeComponents;
+    int freeComponentCount;
 
-    ActiveSound sounds[MAX_SOUNDS];
-    int soundCount;
+    CollisionGrid collisionGrid;
+
+    // Decoded once per file, played through aliases
+    SoundBank sounds;
 
     char *projectPath;
 
@@ -230,7 +379,47 @@ typedef struct
 
     bool shouldBreakFromLoop;
 
+    Continuation *continuations;
+    int continuationCount;
+    int continuationCapacity;
+
+    bool isBytecodeVMOn;
+    BytecodeProgram bytecode;
+
+    // Runs Tick chains, forces and camera shake at FIXED_TICK_RATE instead of once per rendered frame
+    bool isFixedTimestepOn;
+    float tickAccumulator;
+    // Seconds simulated by the current step
+    float deltaTime;
+    // How far the rendered frame is from the previous step to the current one, 1 without the fixed timestep
+    float interpolationAlpha;
+
+    // Draw Debug Line only records lines, DrawComponents draws them once per rendered frame. Lines of the last
+    // simulation step are kept until the next step, lines of input events only for the frame they fired in
+    DebugLineList stepDebugLines;
+    DebugLineList frameDebugLines;
+    bool isRunningStep;
+
+#ifdef RAPID_HEADLESS
+    // Indexed by runtime node, filled by the tree walker when set
+    NodeStats *nodeStats;
+#endif
+
+#ifdef RAPID_PROFILER
+    Profiler profiler;
+#endif
+
     RuntimeGraphContext *runtimeGraph;
+
+    // Backs the runtime graph, values, their strings and the other arrays that live until the game stops.
+    // Reset by FreeInterpreterContext and kept across runs, released with FreeArena
+    Arena arena;
+
+    // Text of every string value of the run, in the arena
+    StringTable strings;
+
+    // Sprite textures of the run, shared by path
+    TextureCache textures;
 } InterpreterContext;
 
 typedef enum
@@ -269,8 +458,31 @@ void FreeInterpreterContext(InterpreterContext *interpreter);
 
 char *ValueTypeToString(ValueType type);
 
-char *ValueToString(Value value);
+char *ValueToString(InterpreterContext *interpreter, Value value);
+
+const char *GetValueString(InterpreterContext *interpreter, Value value);
+
+void AddToLogFromInterpreter(InterpreterContext *interpreter, const char *message, int level);
 
 RuntimeGraphContext ConvertToRuntimeGraph(GraphContext *graph, InterpreterContext *interpreter);
 
+bool CompileRuntimeGraph(InterpreterContext *interpreter, RuntimeGraphContext *graph);
+
+void ExecuteNode(InterpreterContext *interpreter, RuntimeNode *node);
+
+void RunBytecode(InterpreterContext *interpreter, RuntimeGraphContext *graph, int eventNodeIndex);
+
+// Call after a component's position, size or texture changes
+void UpdateComponentTransform(InterpreterContext *interpreter, int componentIndex);
+
+// Copies the sprite at templateIndex into a pooled component and shows it, -1 if out of memory
+int SpawnSpriteInstance(InterpreterContext *interpreter, int templateIndex);
+
+// Returns the instance to the pool, then gives the newest live instance of the same template, or the template itself
+int DestroySpriteInstance(InterpreterContext *interpreter, int componentIndex);
+
+void FreeCollisionGrid(CollisionGrid *grid);
+
+void FreeForceStore(ForceStore *forces);
+
 bool HandleGameScreen(InterpreterContext *interpreter, RuntimeGraphContext *graph, Vector2 mousePos, Rectangle screenBoundary);
\ No newline at end of file
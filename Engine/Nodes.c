@@ -1,104 +1,1559 @@
 // Copyright 2025 Emil Dimov
 // Licensed under the Apache License, Version 2.0
 
+#include <math.h>
+#include <limits.h>
 #include "Nodes.h"
 
-GraphContext InitGraphContext()
+#ifdef _WIN32
+#define GENERIC_READ 0x80000000UL
+#define FILE_SHARE_READ 0x00000001UL
+#define OPEN_EXISTING 3UL
+#define FILE_ATTRIBUTE_NORMAL 0x00000080UL
+#define PAGE_WRITECOPY 0x08UL
+#define FILE_MAP_COPY 0x0001UL
+#define INVALID_HANDLE_VALUE ((void *)(long long)-1)
+
+void *__stdcall CreateFileA(const char *lpFileName, unsigned long dwDesiredAccess, unsigned long dwShareMode, void *lpSecurityAttributes, unsigned long dwCreationDisposition, unsigned long dwFlagsAndAttributes, void *hTemplateFile);
+int __stdcall GetFileSizeEx(void *hFile, long long *lpFileSize);
+void *__stdcall CreateFileMappingA(void *hFile, void *lpFileMappingAttributes, unsigned long flProtect, unsigned long dwMaximumSizeHigh, unsigned long dwMaximumSizeLow, const char *lpName);
+void *__stdcall MapViewOfFile(void *hFileMappingObject, unsigned long dwDesiredAccess, unsigned long dwFileOffsetHigh, unsigned long dwFileOffsetLow, size_t dwNumberOfBytesToMap);
+int __stdcall UnmapViewOfFile(const void *lpBaseAddress);
+int __stdcall CloseHandle(void *hObject);
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+
+#define ID_INDEX_MAP_MIN_CAPACITY 64
+
+static unsigned int HashID(int id, int capacity)
 {
-    GraphContext graph;
+    return ((unsigned int)id * 2654435761u) & (unsigned int)(capacity - 1);
+}
 
-    graph.nodes = NULL;
-    graph.nodeCount = 0;
-    graph.nextNodeID = 1;
+static void FreeIDIndexMap(IDIndexMap *map)
+{
+    free(map->ids);
+    free(map->indexes);
+    *map = (IDIndexMap){0};
+}
 
-    graph.pins = NULL;
-    graph.pinCount = 0;
-    graph.nextPinID = 1;
+static int LookupIDIndex(IDIndexMap *map, int id)
+{
+    if (map->capacity == 0)
+    {
+        return -1;
+    }
 
-    graph.links = NULL;
-    graph.linkCount = 0;
-    graph.nextLinkID = 1;
+    unsigned int mask = map->capacity - 1;
+    for (unsigned int slot = HashID(id, map->capacity); map->indexes[slot] != -1; slot = (slot + 1) & mask)
+    {
+        if (map->ids[slot] == id)
+        {
+            return map->indexes[slot];
+        }
+    }
+    return -1;
+}
 
-    return graph;
+// Caller makes sure there is a free slot
+static void InsertIDIndex(IDIndexMap *map, int id, int index, bool shouldReplace)
+{
+    unsigned int mask = map->capacity - 1;
+    unsigned int slot = HashID(id, map->capacity);
+    while (map->indexes[slot] != -1)
+    {
+        if (map->ids[slot] == id)
+        {
+            if (shouldReplace)
+            {
+                map->indexes[slot] = index;
+            }
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+    map->ids[slot] = id;
+    map->indexes[slot] = index;
 }
 
-void FreeGraphContext(GraphContext *graph)
+static void RemoveIDIndex(IDIndexMap *map, int id)
 {
-    if (!graph)
+    if (map->capacity == 0)
+    {
         return;
+    }
 
-    if (graph->pins)
+    unsigned int mask = map->capacity - 1;
+    unsigned int slot = HashID(id, map->capacity);
+    while (map->indexes[slot] != -1 && map->ids[slot] != id)
     {
-        free(graph->pins);
-        graph->pins = NULL;
+        slot = (slot + 1) & mask;
+    }
+    if (map->indexes[slot] == -1)
+    {
+        return;
+    }
+
+    // Shift the rest of the probe chain back instead of leaving a tombstone
+    for (unsigned int next = (slot + 1) & mask; map->indexes[next] != -1; next = (next + 1) & mask)
+    {
+        unsigned int home = HashID(map->ids[next], map->capacity);
+        if (((next - home) & mask) >= ((next - slot) & mask))
+        {
+            map->ids[slot] = map->ids[next];
+            map->indexes[slot] = map->indexes[next];
+            slot = next;
+        }
+    }
+    map->indexes[slot] = -1;
+}
+
+// Keeps the load factor at or below one half
+static bool ReserveIDIndex(IDIndexMap *map, int count)
+{
+    if (count * 2 <= map->capacity)
+    {
+        return true;
+    }
+
+    int capacity = map->capacity > 0 ? map->capacity : ID_INDEX_MAP_MIN_CAPACITY;
+    while (capacity < count * 2)
+    {
+        capacity *= 2;
+    }
+
+    IDIndexMap grown = {.ids = malloc(sizeof(int) * capacity), .indexes = malloc(sizeof(int) * capacity), .capacity = capacity, .count = map->count};
+    if (!grown.ids || !grown.indexes)
+    {
+        free(grown.ids);
+        free(grown.indexes);
+        return false;
+    }
+    memset(grown.indexes, -1, sizeof(int) * capacity);
+
+    for (int i = 0; i < map->capacity; i++)
+    {
+        if (map->indexes[i] != -1)
+        {
+            InsertIDIndex(&grown, map->ids[i], map->indexes[i], true);
+        }
+    }
+
+    free(map->ids);
+    free(map->indexes);
+    *map = grown;
+    return true;
+}
+
+static bool RebuildPinIndex(GraphContext *graph)
+{
+    IDIndexMap *map = &graph->pinIndexByID;
+    if (map->capacity > 0)
+    {
+        memset(map->indexes, -1, sizeof(int) * map->capacity);
+    }
+    if (!ReserveIDIndex(map, graph->pinCount))
+    {
+        FreeIDIndexMap(map);
+        return false;
+    }
+
+    // On duplicate IDs the first pin wins, same as a linear scan
+    for (int i = 0; i < graph->pinCount; i++)
+    {
+        InsertIDIndex(map, graph->pins[i].id, i, false);
+    }
+    map->count = graph->pinCount;
+    return true;
+}
+
+static bool RebuildNodeIndex(GraphContext *graph)
+{
+    IDIndexMap *map = &graph->nodeIndexByID;
+    if (map->capacity > 0)
+    {
+        memset(map->indexes, -1, sizeof(int) * map->capacity);
+    }
+    if (!ReserveIDIndex(map, graph->nodeCount))
+    {
+        FreeIDIndexMap(map);
+        return false;
+    }
+
+    for (int i = 0; i < graph->nodeCount; i++)
+    {
+        InsertIDIndex(map, graph->nodes[i].id, i, false);
+    }
+    map->count = graph->nodeCount;
+    return true;
+}
+
+// Called after appending to the pin or node array. An index that was already out of date is left to be rebuilt on the next lookup
+static void IndexAppendedID(IDIndexMap *map, int id, int index)
+{
+    if (map->count != index)
+    {
+        return;
+    }
+    if (!ReserveIDIndex(map, index + 1))
+    {
+        FreeIDIndexMap(map);
+        return;
+    }
+    InsertIDIndex(map, id, index, false);
+    map->count++;
+}
+
+// Called after the element at index was replaced by the last one
+static void UnindexSwapRemovedID(IDIndexMap *map, int removedID, int movedID, int index, int countBefore)
+{
+    if (map->count != countBefore)
+    {
+        return;
+    }
+    RemoveIDIndex(map, removedID);
+    if (index != countBefore - 1)
+    {
+        InsertIDIndex(map, movedID, index, true);
+    }
+    map->count--;
+}
+
+static Rectangle GetNodeRect(const Node *node)
+{
+    return (Rectangle){node->position.x, node->position.y, getNodeInfoByType(node->type, INFO_NODE_WIDTH), getNodeInfoByType(node->type, INFO_NODE_HEIGHT)};
+}
+
+// Rects covering more than maxCells cells are oversized
+static NodeGridRange GetNodeGridRange(Rectangle rect, float maxCells)
+{
+    float minX = floorf(rect.x / NODE_GRID_CELL_SIZE);
+    float minY = floorf(rect.y / NODE_GRID_CELL_SIZE);
+    float maxX = floorf((rect.x + rect.width) / NODE_GRID_CELL_SIZE);
+    float maxY = floorf((rect.y + rect.height) / NODE_GRID_CELL_SIZE);
+
+    // Also catches NaN and positions too far out to fit a cell index
+    if (!((maxX - minX + 1) * (maxY - minY + 1) <= maxCells) || !(fabsf(minX) < 1e6f && fabsf(minY) < 1e6f))
+    {
+        return (NodeGridRange){.isOversized = true};
+    }
+
+    return (NodeGridRange){(int)minX, (int)minY, (int)maxX, (int)maxY, false};
+}
+
+static NodeGridBucket *GetNodeGridBucket(NodeGrid *grid, int cellX, int cellY)
+{
+    unsigned int hash = ((unsigned int)cellX * 73856093u) ^ ((unsigned int)cellY * 19349663u);
+    return &grid->buckets[hash & (NODE_GRID_BUCKET_COUNT - 1)];
+}
+
+static bool AddToNodeGridBucket(NodeGridBucket *bucket, int nodeIndex)
+{
+    if (bucket->count >= bucket->capacity)
+    {
+        int newCapacity = bucket->capacity ? bucket->capacity * 2 : 4;
+        int *newIndexes = realloc(bucket->nodeIndexes, sizeof(int) * newCapacity);
+        if (!newIndexes)
+        {
+            return false;
+        }
+        bucket->nodeIndexes = newIndexes;
+        bucket->capacity = newCapacity;
+    }
+
+    bucket->nodeIndexes[bucket->count++] = nodeIndex;
+    return true;
+}
+
+static void RemoveFromNodeGridBucket(NodeGridBucket *bucket, int nodeIndex)
+{
+    for (int i = 0; i < bucket->count; i++)
+    {
+        if (bucket->nodeIndexes[i] == nodeIndex)
+        {
+            bucket->nodeIndexes[i] = bucket->nodeIndexes[--bucket->count];
+            return;
+        }
+    }
+}
+
+static bool InsertIntoNodeGrid(NodeGrid *grid, int nodeIndex, NodeGridRange range)
+{
+    if (range.isOversized)
+    {
+        return AddToNodeGridBucket(&grid->oversized, nodeIndex);
+    }
+
+    for (int y = range.minY; y <= range.maxY; y++)
+    {
+        for (int x = range.minX; x <= range.maxX; x++)
+        {
+            if (!AddToNodeGridBucket(GetNodeGridBucket(grid, x, y), nodeIndex))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void RemoveFromNodeGrid(NodeGrid *grid, int nodeIndex, NodeGridRange range)
+{
+    if (range.isOversized)
+    {
+        RemoveFromNodeGridBucket(&grid->oversized, nodeIndex);
+        return;
+    }
+
+    for (int y = range.minY; y <= range.maxY; y++)
+    {
+        for (int x = range.minX; x <= range.maxX; x++)
+        {
+            RemoveFromNodeGridBucket(GetNodeGridBucket(grid, x, y), nodeIndex);
+        }
+    }
+}
+
+static void FreeNodeGrid(NodeGrid *grid)
+{
+    if (grid->buckets)
+    {
+        for (int i = 0; i < NODE_GRID_BUCKET_COUNT; i++)
+        {
+            free(grid->buckets[i].nodeIndexes);
+        }
+        free(grid->buckets);
+    }
+    free(grid->oversized.nodeIndexes);
+    free(grid->rangeByNode);
+    free(grid->results);
+    free(grid->queryStampByNode);
+
+    *grid = (NodeGrid){0};
+}
+
+// On failure the grid is dropped and queries fall back to testing every node
+static void DisableNodeGrid(NodeGrid *grid)
+{
+    FreeNodeGrid(grid);
+    grid->hasFailed = true;
+}
+
+static bool ReserveNodeGridRanges(NodeGrid *grid, int nodeCount)
+{
+    if (nodeCount <= grid->rangeCapacity)
+    {
+        return true;
+    }
+
+    int newCapacity = grid->rangeCapacity ? grid->rangeCapacity : 64;
+    while (newCapacity < nodeCount)
+    {
+        newCapacity *= 2;
+    }
+
+    NodeGridRange *newRanges = realloc(grid->rangeByNode, sizeof(NodeGridRange) * newCapacity);
+    if (!newRanges)
+    {
+        return false;
+    }
+    grid->rangeByNode = newRanges;
+    grid->rangeCapacity = newCapacity;
+    return true;
+}
+
+// Bucket allocations are kept, so rebuilding after a pan does not allocate again
+static bool BuildNodeGrid(GraphContext *graph)
+{
+    NodeGrid *grid = &graph->nodeGrid;
+
+    if (!grid->buckets)
+    {
+        grid->buckets = calloc(NODE_GRID_BUCKET_COUNT, sizeof(NodeGridBucket));
+    }
+    if (!grid->buckets || !ReserveNodeGridRanges(grid, graph->nodeCount))
+    {
+        DisableNodeGrid(grid);
+        return false;
+    }
+
+    for (int i = 0; i < NODE_GRID_BUCKET_COUNT; i++)
+    {
+        grid->buckets[i].count = 0;
+    }
+    grid->oversized.count = 0;
+
+    for (int i = 0; i < graph->nodeCount; i++)
+    {
+        grid->rangeByNode[i] = GetNodeGridRange(GetNodeRect(&graph->nodes[i]), NODE_GRID_MAX_CELLS_PER_NODE);
+        if (!InsertIntoNodeGrid(grid, i, grid->rangeByNode[i]))
+        {
+            DisableNodeGrid(grid);
+            return false;
+        }
+    }
+
+    grid->isBuilt = true;
+    return true;
+}
+
+// Called after appending to the node array
+static void IndexAppendedNode(GraphContext *graph)
+{
+    NodeGrid *grid = &graph->nodeGrid;
+    if (!grid->isBuilt)
+    {
+        return;
+    }
+
+    int nodeIndex = graph->nodeCount - 1;
+    if (!ReserveNodeGridRanges(grid, graph->nodeCount))
+    {
+        DisableNodeGrid(grid);
+        return;
+    }
+
+    grid->rangeByNode[nodeIndex] = GetNodeGridRange(GetNodeRect(&graph->nodes[nodeIndex]), NODE_GRID_MAX_CELLS_PER_NODE);
+    if (!InsertIntoNodeGrid(grid, nodeIndex, grid->rangeByNode[nodeIndex]))
+    {
+        DisableNodeGrid(grid);
+    }
+}
+
+// Called before the node at index is replaced by the last one
+static void UnindexSwapRemovedNode(GraphContext *graph, int nodeIndex)
+{
+    NodeGrid *grid = &graph->nodeGrid;
+    if (!grid->isBuilt)
+    {
+        return;
+    }
+
+    int lastIndex = graph->nodeCount - 1;
+    RemoveFromNodeGrid(grid, nodeIndex, grid->rangeByNode[nodeIndex]);
+    if (nodeIndex != lastIndex)
+    {
+        RemoveFromNodeGrid(grid, lastIndex, grid->rangeByNode[lastIndex]);
+        grid->rangeByNode[nodeIndex] = grid->rangeByNode[lastIndex];
+        if (!InsertIntoNodeGrid(grid, nodeIndex, grid->rangeByNode[nodeIndex]))
+        {
+            DisableNodeGrid(grid);
+        }
+    }
+}
+
+// Maps the whole file copy-on-write, so writes through the view go to private pages and never reach the file
+static void *MapGraphFile(const char *filename, size_t *size)
+{
+    void *view = NULL;
+    *size = 0;
+
+#ifdef _WIN32
+    void *file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return NULL;
+    }
+
+    long long fileSize = 0;
+    if (GetFileSizeEx(file, &fileSize) && fileSize > 0)
+    {
+        void *mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+        if (mapping)
+        {
+            view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    int file = open(filename, O_RDONLY);
+    if (file < 0)
+    {
+        return NULL;
+    }
+
+    struct stat fileStat;
+    long long fileSize = 0;
+    if (fstat(file, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        fileSize = fileStat.st_size;
+        view = mmap(NULL, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+        if (view == MAP_FAILED)
+        {
+            view = NULL;
+        }
+    }
+    close(file);
+#endif
+
+    if (view)
+    {
+        *size = (size_t)fileSize;
+    }
+    return view;
+}
+
+static void UnmapGraphFile(GraphContext *graph)
+{
+    if (!graph->mappedView)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(graph->mappedView);
+#else
+    munmap(graph->mappedView, graph->mappedSize);
+#endif
+
+    graph->mappedView = NULL;
+    graph->mappedSize = 0;
+}
+
+// Copies mapped nodes, pins and links into their own allocations before anything resizes or frees them
+static bool DetachMappedArrays(GraphContext *graph)
+{
+    // A damaged mapping is replaced by decoded or empty arrays, which are already detached
+    VerifyMappedArrays(graph);
+    if (!graph->mappedView)
+    {
+        return true;
+    }
+
+    Node *nodes = malloc(sizeof(Node) * (graph->nodeCount > 0 ? graph->nodeCount : 1));
+    Pin *pins = malloc(sizeof(Pin) * (graph->pinCount > 0 ? graph->pinCount : 1));
+    Link *links = malloc(sizeof(Link) * (graph->linkCount > 0 ? graph->linkCount : 1));
+    if (!nodes || !pins || !links)
+    {
+        free(nodes);
+        free(pins);
+        free(links);
+        return false;
+    }
+
+    memcpy(nodes, graph->nodes, sizeof(Node) * graph->nodeCount);
+    memcpy(pins, graph->pins, sizeof(Pin) * graph->pinCount);
+    memcpy(links, graph->links, sizeof(Link) * graph->linkCount);
+
+    UnmapGraphFile(graph);
+
+    graph->nodes = nodes;
+    graph->pins = pins;
+    graph->links = links;
+    return true;
+}
+
+GraphContext InitGraphContext()
+{
+    GraphContext graph;
+
+    graph.nodes = NULL;
+    graph.nodeCount = 0;
+    graph.nextNodeID = 1;
+
+    graph.pins = NULL;
+    graph.pinCount = 0;
+    graph.nextPinID = 1;
+
+    graph.links = NULL;
+    graph.linkCount = 0;
+    graph.nextLinkID = 1;
+
+    graph.pinIndexByID = (IDIndexMap){0};
+    graph.nodeIndexByID = (IDIndexMap){0};
+
+    graph.nodeIndexByPin = NULL;
+    graph.linkEndpoints = NULL;
+    graph.isDrawCacheValid = false;
+
+    graph.nodeGrid = (NodeGrid){0};
+
+    graph.mappedView = NULL;
+    graph.mappedSize = 0;
+    graph.isMappingVerified = false;
+
+    return graph;
+}
+
+void FreeGraphContext(GraphContext *graph)
+{
+    if (!graph)
+        return;
+
+    if (graph->mappedView)
+    {
+        UnmapGraphFile(graph);
+        graph->nodes = NULL;
+        graph->pins = NULL;
+        graph->links = NULL;
+    }
+
+    if (graph->pins)
+    {
+        free(graph->pins);
+        graph->pins = NULL;
+    }
+
+    if (graph->links)
+    {
+        free(graph->links);
+        graph->links = NULL;
+    }
+
+    if (graph->nodes)
+    {
+        free(graph->nodes);
+        graph->nodes = NULL;
+    }
+
+    FreeIDIndexMap(&graph->pinIndexByID);
+    FreeIDIndexMap(&graph->nodeIndexByID);
+
+    free(graph->nodeIndexByPin);
+    free(graph->linkEndpoints);
+    graph->nodeIndexByPin = NULL;
+    graph->linkEndpoints = NULL;
+    graph->isDrawCacheValid = false;
+
+    FreeNodeGrid(&graph->nodeGrid);
+
+    graph->nodeCount = 0;
+    graph->nextNodeID = 0;
+    graph->pinCount = 0;
+    graph->nextPinID = 0;
+    graph->linkCount = 0;
+    graph->nextLinkID = 0;
+}
+
+int FindPinIndexByID(GraphContext *graph, int id)
+{
+    if (graph->pinIndexByID.count == graph->pinCount)
+    {
+        int index = LookupIDIndex(&graph->pinIndexByID, id);
+        if (index == -1 || (index < graph->pinCount && graph->pins[index].id == id))
+        {
+            return index;
+        }
+    }
+
+    if (RebuildPinIndex(graph))
+    {
+        return LookupIDIndex(&graph->pinIndexByID, id);
+    }
+
+    for (int i = 0; i < graph->pinCount; i++)
+    {
+        if (graph->pins[i].id == id)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int FindNodeIndexByID(GraphContext *graph, int id)
+{
+    if (graph->nodeIndexByID.count == graph->nodeCount)
+    {
+        int index = LookupIDIndex(&graph->nodeIndexByID, id);
+        if (index == -1 || (index < graph->nodeCount && graph->nodes[index].id == id))
+        {
+            return index;
+        }
+    }
+
+    if (RebuildNodeIndex(graph))
+    {
+        return LookupIDIndex(&graph->nodeIndexByID, id);
+    }
+
+    for (int i = 0; i < graph->nodeCount; i++)
+    {
+        if (graph->nodes[i].id == id)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+typedef struct
+{
+    unsigned char *data;
+    size_t size;
+    size_t capacity;
+    bool hasFailed;
+} GraphFileBuffer;
+
+typedef struct
+{
+    const unsigned char *data;
+    size_t size;
+    size_t offset;
+    bool hasFailed;
+} GraphChunkReader;
+
+typedef enum
+{
+    PIN_DATA_NONE,
+    PIN_DATA_TEXT,
+    PIN_DATA_OPTION,
+    PIN_DATA_HITBOX
+} PinDataKind;
+
+static PinDataKind GetPinDataKind(PinType type)
+{
+    switch (type)
+    {
+    case PIN_FIELD_NUM:
+    case PIN_FIELD_STRING:
+    case PIN_FIELD_BOOL:
+    case PIN_FIELD_COLOR:
+        return PIN_DATA_TEXT;
+    case PIN_FIELD_KEY:
+    case PIN_DROPDOWN_COMPARISON_OPERATOR:
+    case PIN_DROPDOWN_GATE:
+    case PIN_DROPDOWN_ARITHMETIC:
+    case PIN_DROPDOWN_KEY_ACTION:
+    case PIN_DROPDOWN_LAYER:
+    case PIN_VARIABLE:
+    case PIN_SPRITE_VARIABLE:
+        return PIN_DATA_OPTION;
+    case PIN_EDIT_HITBOX:
+        return PIN_DATA_HITBOX;
+    default:
+        return PIN_DATA_NONE;
+    }
+}
+
+// CRC-32, eight bytes per step
+static unsigned int ComputeChecksum(const unsigned char *data, size_t size)
+{
+    static unsigned int table[8][256];
+    static bool isTableReady = false;
+
+    if (!isTableReady)
+    {
+        for (unsigned int i = 0; i < 256; i++)
+        {
+            unsigned int crc = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            }
+            table[0][i] = crc;
+        }
+        for (int k = 1; k < 8; k++)
+        {
+            for (int i = 0; i < 256; i++)
+            {
+                table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+            }
+        }
+        isTableReady = true;
+    }
+
+    unsigned int crc = 0xFFFFFFFFu;
+    for (; size >= 8; data += 8, size -= 8)
+    {
+        crc ^= data[0] | (data[1] << 8) | (data[2] << 16) | ((unsigned int)data[3] << 24);
+        crc = table[7][crc & 0xFF] ^ table[6][(crc >> 8) & 0xFF] ^ table[5][(crc >> 16) & 0xFF] ^ table[4][crc >> 24] ^
+              table[3][data[4]] ^ table[2][data[5]] ^ table[1][data[6]] ^ table[0][data[7]];
+    }
+    for (; size > 0; data++, size--)
+    {
+        crc = table[0][(crc ^ *data) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+static size_t AlignGraphFileSize(size_t size)
+{
+    return (size + GRAPH_FILE_ALIGNMENT - 1) & ~(size_t)(GRAPH_FILE_ALIGNMENT - 1);
+}
+
+static int GetBoundedLength(const char *text, int maxSize)
+{
+    int length = 0;
+    while (length < maxSize - 1 && text[length] != '\0')
+    {
+        length++;
+    }
+    return length;
+}
+
+static void WriteBytesToGraphFile(GraphFileBuffer *buffer, const void *bytes, size_t size)
+{
+    if (buffer->hasFailed)
+    {
+        return;
+    }
+
+    if (buffer->size + size > buffer->capacity)
+    {
+        size_t newCapacity = buffer->capacity > 0 ? buffer->capacity : 4096;
+        while (newCapacity < buffer->size + size)
+        {
+            newCapacity *= 2;
+        }
+        unsigned char *newData = realloc(buffer->data, newCapacity);
+        if (!newData)
+        {
+            buffer->hasFailed = true;
+            return;
+        }
+        buffer->data = newData;
+        buffer->capacity = newCapacity;
+    }
+
+    if (bytes)
+    {
+        memcpy(buffer->data + buffer->size, bytes, size);
+    }
+    else
+    {
+        memset(buffer->data + buffer->size, 0, size);
+    }
+    buffer->size += size;
+}
+
+static void WriteIntToGraphFile(GraphFileBuffer *buffer, int value)
+{
+    WriteBytesToGraphFile(buffer, &value, sizeof(int));
+}
+
+static void WriteFloatToGraphFile(GraphFileBuffer *buffer, float value)
+{
+    WriteBytesToGraphFile(buffer, &value, sizeof(float));
+}
+
+// Returns the offset of the chunk header, which EndGraphChunk fills in once the payload is written
+static size_t BeginGraphChunk(GraphFileBuffer *buffer, unsigned int tag)
+{
+    size_t offset = buffer->size;
+    GraphChunkHeader chunk = {.tag = tag};
+    WriteBytesToGraphFile(buffer, &chunk, sizeof(GraphChunkHeader));
+    return offset;
+}
+
+static void EndGraphChunk(GraphFileBuffer *buffer, size_t offset)
+{
+    if (buffer->hasFailed)
+    {
+        return;
+    }
+
+    GraphChunkHeader chunk;
+    memcpy(&chunk, buffer->data + offset, sizeof(GraphChunkHeader));
+    size_t payloadOffset = offset + sizeof(GraphChunkHeader);
+    chunk.size = (int)(buffer->size - payloadOffset);
+    chunk.checksum = ComputeChecksum(buffer->data + payloadOffset, chunk.size);
+    memcpy(buffer->data + offset, &chunk, sizeof(GraphChunkHeader));
+
+    WriteBytesToGraphFile(buffer, NULL, AlignGraphFileSize(chunk.size) - chunk.size);
+}
+
+static void WritePinRecord(GraphFileBuffer *buffer, const Pin *pin)
+{
+    WriteIntToGraphFile(buffer, pin->id);
+    WriteIntToGraphFile(buffer, pin->type);
+    WriteIntToGraphFile(buffer, pin->nodeID);
+    WriteIntToGraphFile(buffer, pin->posInNode);
+    WriteFloatToGraphFile(buffer, pin->position.x);
+    WriteFloatToGraphFile(buffer, pin->position.y);
+    WriteIntToGraphFile(buffer, (pin->isInput ? 1 : 0) | (pin->isNumFloat ? 2 : 0));
+
+    switch (GetPinDataKind(pin->type))
+    {
+    case PIN_DATA_TEXT:
+    {
+        int length = GetBoundedLength(pin->textFieldValue, MAX_LITERAL_NODE_FIELD_SIZE);
+        WriteIntToGraphFile(buffer, length);
+        WriteBytesToGraphFile(buffer, pin->textFieldValue, length);
+        break;
+    }
+    case PIN_DATA_OPTION:
+        WriteIntToGraphFile(buffer, pin->pickedOption);
+        break;
+    case PIN_DATA_HITBOX:
+    {
+        int count = pin->hitbox.count < 0 ? 0 : (pin->hitbox.count > MAX_POLYGON_VERTICES ? MAX_POLYGON_VERTICES : pin->hitbox.count);
+        WriteIntToGraphFile(buffer, count);
+        WriteIntToGraphFile(buffer, pin->hitbox.isClosed ? 1 : 0);
+        WriteBytesToGraphFile(buffer, pin->hitbox.vertices, sizeof(Vector2) * count);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+static void WriteArrayChunk(GraphFileBuffer *buffer, unsigned int tag, const void *elements, int elementSize, int elementCount)
+{
+    size_t chunk = BeginGraphChunk(buffer, tag);
+    WriteIntToGraphFile(buffer, elementSize);
+    WriteIntToGraphFile(buffer, elementCount);
+    WriteBytesToGraphFile(buffer, elements, (size_t)elementSize * elementCount);
+    EndGraphChunk(buffer, chunk);
+}
+
+int SaveGraphToFile(const char *filename, GraphContext *graph)
+{
+    // The file is about to be overwritten, so it can't stay mapped
+    if (!DetachMappedArrays(graph))
+    {
+        return 1;
+    }
+
+    bool isMappable = graph->nodeCount >= GRAPH_FILE_MAPPED_MIN_NODES;
+
+    GraphFileBuffer buffer = {0};
+
+    GraphFileHeader header = {.version = GRAPH_FILE_VERSION, .flags = GRAPH_FILE_FLAG_CHECKSUMS | (isMappable ? GRAPH_FILE_FLAG_MAPPABLE : 0), .chunkCount = isMappable ? 7 : 4};
+    memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+    WriteBytesToGraphFile(&buffer, &header, sizeof(GraphFileHeader));
+
+    size_t chunk = BeginGraphChunk(&buffer, GRAPH_CHUNK_INFO);
+    WriteIntToGraphFile(&buffer, graph->nextNodeID);
+    WriteIntToGraphFile(&buffer, graph->nextPinID);
+    WriteIntToGraphFile(&buffer, graph->nextLinkID);
+    WriteIntToGraphFile(&buffer, graph->nodeCount);
+    WriteIntToGraphFile(&buffer, graph->pinCount);
+    WriteIntToGraphFile(&buffer, graph->linkCount);
+    EndGraphChunk(&buffer, chunk);
+
+    chunk = BeginGraphChunk(&buffer, GRAPH_CHUNK_NODES);
+    for (int i = 0; i < graph->nodeCount; i++)
+    {
+        Node *node = &graph->nodes[i];
+        int nameLength = GetBoundedLength(node->name, MAX_VARIABLE_NAME_SIZE);
+
+        WriteIntToGraphFile(&buffer, node->id);
+        WriteIntToGraphFile(&buffer, node->type);
+        WriteFloatToGraphFile(&buffer, node->position.x);
+        WriteFloatToGraphFile(&buffer, node->position.y);
+        WriteIntToGraphFile(&buffer, node->inputCount);
+        WriteIntToGraphFile(&buffer, node->outputCount);
+        WriteBytesToGraphFile(&buffer, node->inputPins, sizeof(int) * node->inputCount);
+        WriteBytesToGraphFile(&buffer, node->outputPins, sizeof(int) * node->outputCount);
+        WriteIntToGraphFile(&buffer, nameLength);
+        WriteBytesToGraphFile(&buffer, node->name, nameLength);
+    }
+    EndGraphChunk(&buffer, chunk);
+
+    chunk = BeginGraphChunk(&buffer, GRAPH_CHUNK_PINS);
+    for (int i = 0; i < graph->pinCount; i++)
+    {
+        WritePinRecord(&buffer, &graph->pins[i]);
+    }
+    EndGraphChunk(&buffer, chunk);
+
+    chunk = BeginGraphChunk(&buffer, GRAPH_CHUNK_LINKS);
+    for (int i = 0; i < graph->linkCount; i++)
+    {
+        WriteIntToGraphFile(&buffer, graph->links[i].inputPinID);
+        WriteIntToGraphFile(&buffer, graph->links[i].outputPinID);
+    }
+    EndGraphChunk(&buffer, chunk);
+
+    if (isMappable)
+    {
+        WriteArrayChunk(&buffer, GRAPH_CHUNK_NODE_ARRAY, graph->nodes, sizeof(Node), graph->nodeCount);
+        WriteArrayChunk(&buffer, GRAPH_CHUNK_PIN_ARRAY, graph->pins, sizeof(Pin), graph->pinCount);
+        WriteArrayChunk(&buffer, GRAPH_CHUNK_LINK_ARRAY, graph->links, sizeof(Link), graph->linkCount);
+    }
+
+    if (buffer.hasFailed)
+    {
+        free(buffer.data);
+        return 1;
+    }
+
+    FILE *file = fopen(filename, "wb");
+    if (!file)
+    {
+        free(buffer.data);
+        return 1;
+    }
+
+    size_t written = fwrite(buffer.data, 1, buffer.size, file);
+
+    fclose(file);
+    free(buffer.data);
+
+    return written == buffer.size ? 0 : 1;
+}
+
+static void ReadBytesFromChunk(GraphChunkReader *reader, void *bytes, size_t size)
+{
+    if (reader->hasFailed || size > reader->size - reader->offset)
+    {
+        reader->hasFailed = true;
+        return;
+    }
+    memcpy(bytes, reader->data + reader->offset, size);
+    reader->offset += size;
+}
+
+static int ReadIntFromChunk(GraphChunkReader *reader)
+{
+    int value = 0;
+    ReadBytesFromChunk(reader, &value, sizeof(int));
+    return value;
+}
+
+static float ReadFloatFromChunk(GraphChunkReader *reader)
+{
+    float value = 0;
+    ReadBytesFromChunk(reader, &value, sizeof(float));
+    return value;
+}
+
+static bool ReadGraphInfoChunk(GraphChunkReader *reader, GraphContext *graph)
+{
+    graph->nextNodeID = ReadIntFromChunk(reader);
+    graph->nextPinID = ReadIntFromChunk(reader);
+    graph->nextLinkID = ReadIntFromChunk(reader);
+    int nodeCount = ReadIntFromChunk(reader);
+    int pinCount = ReadIntFromChunk(reader);
+    int linkCount = ReadIntFromChunk(reader);
+
+    if (reader->hasFailed || nodeCount < 0 || pinCount < 0 || linkCount < 0)
+    {
+        return false;
+    }
+
+    graph->nodeCount = nodeCount;
+    graph->pinCount = pinCount;
+    graph->linkCount = linkCount;
+    return true;
+}
+
+static bool AllocateGraphArrays(GraphContext *graph)
+{
+    // Zeroed so pins without stored data come back the same as from CreatePin
+    graph->nodes = calloc(graph->nodeCount, sizeof(Node));
+    graph->pins = calloc(graph->pinCount, sizeof(Pin));
+    graph->links = calloc(graph->linkCount, sizeof(Link));
+
+    return (graph->nodeCount == 0 || graph->nodes) && (graph->pinCount == 0 || graph->pins) && (graph->linkCount == 0 || graph->links);
+}
+
+static bool ReadNodesChunk(GraphChunkReader *reader, GraphContext *graph)
+{
+    for (int i = 0; i < graph->nodeCount && !reader->hasFailed; i++)
+    {
+        Node *node = &graph->nodes[i];
+
+        node->id = ReadIntFromChunk(reader);
+        node->type = ReadIntFromChunk(reader);
+        node->position.x = ReadFloatFromChunk(reader);
+        node->position.y = ReadFloatFromChunk(reader);
+        node->inputCount = ReadIntFromChunk(reader);
+        node->outputCount = ReadIntFromChunk(reader);
+        if (node->inputCount < 0 || node->inputCount > MAX_NODE_PINS || node->outputCount < 0 || node->outputCount > MAX_NODE_PINS)
+        {
+            return false;
+        }
+        ReadBytesFromChunk(reader, node->inputPins, sizeof(int) * node->inputCount);
+        ReadBytesFromChunk(reader, node->outputPins, sizeof(int) * node->outputCount);
+
+        int nameLength = ReadIntFromChunk(reader);
+        if (nameLength < 0 || nameLength >= MAX_VARIABLE_NAME_SIZE)
+        {
+            return false;
+        }
+        ReadBytesFromChunk(reader, node->name, nameLength);
+        node->name[nameLength] = '\0';
+    }
+    return !reader->hasFailed;
+}
+
+static bool ReadPinsChunk(GraphChunkReader *reader, GraphContext *graph)
+{
+    for (int i = 0; i < graph->pinCount && !reader->hasFailed; i++)
+    {
+        Pin *pin = &graph->pins[i];
+
+        pin->id = ReadIntFromChunk(reader);
+        pin->type = ReadIntFromChunk(reader);
+        pin->nodeID = ReadIntFromChunk(reader);
+        pin->posInNode = ReadIntFromChunk(reader);
+        pin->position.x = ReadFloatFromChunk(reader);
+        pin->position.y = ReadFloatFromChunk(reader);
+        int flags = ReadIntFromChunk(reader);
+        pin->isInput = (flags & 1) != 0;
+        pin->isNumFloat = (flags & 2) != 0;
+
+        switch (GetPinDataKind(pin->type))
+        {
+        case PIN_DATA_TEXT:
+        {
+            int length = ReadIntFromChunk(reader);
+            if (length < 0 || length >= MAX_LITERAL_NODE_FIELD_SIZE)
+            {
+                return false;
+            }
+            ReadBytesFromChunk(reader, pin->textFieldValue, length);
+            pin->textFieldValue[length] = '\0';
+            break;
+        }
+        case PIN_DATA_OPTION:
+            pin->pickedOption = ReadIntFromChunk(reader);
+            break;
+        case PIN_DATA_HITBOX:
+            pin->hitbox.count = ReadIntFromChunk(reader);
+            pin->hitbox.isClosed = ReadIntFromChunk(reader) != 0;
+            if (pin->hitbox.count < 0 || pin->hitbox.count > MAX_POLYGON_VERTICES)
+            {
+                return false;
+            }
+            ReadBytesFromChunk(reader, pin->hitbox.vertices, sizeof(Vector2) * pin->hitbox.count);
+            break;
+        default:
+            break;
+        }
+    }
+    return !reader->hasFailed;
+}
+
+static bool ReadLinksChunk(GraphChunkReader *reader, GraphContext *graph)
+{
+    for (int i = 0; i < graph->linkCount && !reader->hasFailed; i++)
+    {
+        graph->links[i].inputPinID = ReadIntFromChunk(reader);
+        graph->links[i].outputPinID = ReadIntFromChunk(reader);
+    }
+    return !reader->hasFailed;
+}
+
+// Reads one chunk at a time into a reused buffer and decodes it straight into the arrays sized by the info chunk
+typedef struct
+{
+    bool hasInfo;
+    bool hasNodes;
+    bool hasPins;
+    bool hasLinks;
+} DecodedGraphChunks;
+
+static bool IsDecodedGraphChunk(unsigned int tag)
+{
+    return tag == GRAPH_CHUNK_INFO || tag == GRAPH_CHUNK_NODES || tag == GRAPH_CHUNK_PINS || tag == GRAPH_CHUNK_LINKS;
+}
+
+static bool DecodeGraphChunk(unsigned int tag, GraphChunkReader *reader, GraphContext *graph, DecodedGraphChunks *decoded)
+{
+    bool isValid = true;
+    switch (tag)
+    {
+    case GRAPH_CHUNK_INFO:
+        isValid = !decoded->hasInfo && ReadGraphInfoChunk(reader, graph) && AllocateGraphArrays(graph);
+        decoded->hasInfo = true;
+        break;
+    case GRAPH_CHUNK_NODES:
+        isValid = decoded->hasInfo && !decoded->hasNodes && ReadNodesChunk(reader, graph);
+        decoded->hasNodes = true;
+        break;
+    case GRAPH_CHUNK_PINS:
+        isValid = decoded->hasInfo && !decoded->hasPins && ReadPinsChunk(reader, graph);
+        decoded->hasPins = true;
+        break;
+    case GRAPH_CHUNK_LINKS:
+        isValid = decoded->hasInfo && !decoded->hasLinks && ReadLinksChunk(reader, graph);
+        decoded->hasLinks = true;
+        break;
+    }
+    return isValid;
+}
+
+static bool LoadChunkedGraph(FILE *file, GraphContext *graph)
+{
+    GraphFileHeader header;
+    if (fread(&header, sizeof(GraphFileHeader), 1, file) != 1 || header.version < 1 || header.version > GRAPH_FILE_VERSION)
+    {
+        return false;
+    }
+
+    unsigned char *payload = NULL;
+    size_t payloadCapacity = 0;
+    DecodedGraphChunks decoded = {0};
+    bool isValid = true;
+
+    for (int i = 0; i < header.chunkCount && isValid; i++)
+    {
+        GraphChunkHeader chunk;
+        if (fread(&chunk, sizeof(GraphChunkHeader), 1, file) != 1 || chunk.size < 0)
+        {
+            isValid = false;
+            break;
+        }
+
+        size_t paddedSize = AlignGraphFileSize(chunk.size);
+        if (!IsDecodedGraphChunk(chunk.tag))
+        {
+            isValid = fseek(file, (long)paddedSize, SEEK_CUR) == 0;
+            continue;
+        }
+
+        if (paddedSize > payloadCapacity)
+        {
+            unsigned char *newPayload = realloc(payload, paddedSize);
+            if (!newPayload)
+            {
+                isValid = false;
+                break;
+            }
+            payload = newPayload;
+            payloadCapacity = paddedSize;
+        }
+
+        if (fread(payload, 1, paddedSize, file) != paddedSize)
+        {
+            isValid = false;
+            break;
+        }
+
+        if ((header.flags & GRAPH_FILE_FLAG_CHECKSUMS) && ComputeChecksum(payload, chunk.size) != chunk.checksum)
+        {
+            isValid = false;
+            break;
+        }
+
+        GraphChunkReader reader = {.data = payload, .size = chunk.size};
+        isValid = DecodeGraphChunk(chunk.tag, &reader, graph, &decoded);
+    }
+
+    free(payload);
+
+    return isValid && decoded.hasInfo && decoded.hasNodes && decoded.hasPins && decoded.hasLinks;
+}
+
+static bool IsBoolByteValid(const bool *value)
+{
+    return *(const unsigned char *)value <= 1;
+}
+
+// The mapped arrays are used as they are, so every node is held to what ReadNodesChunk accepts
+static bool AreMappedNodesValid(const Node *nodes, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const Node *node = &nodes[i];
+        if (node->inputCount < 0 || node->inputCount > MAX_NODE_PINS || node->outputCount < 0 || node->outputCount > MAX_NODE_PINS)
+        {
+            return false;
+        }
+        if (memchr(node->name, '\0', MAX_VARIABLE_NAME_SIZE) == NULL)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool AreMappedPinsValid(const Pin *pins, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const Pin *pin = &pins[i];
+        if (!IsBoolByteValid(&pin->isInput) || !IsBoolByteValid(&pin->isNumFloat))
+        {
+            return false;
+        }
+
+        switch (GetPinDataKind(pin->type))
+        {
+        case PIN_DATA_TEXT:
+            if (memchr(pin->textFieldValue, '\0', MAX_LITERAL_NODE_FIELD_SIZE) == NULL)
+            {
+                return false;
+            }
+            break;
+        case PIN_DATA_HITBOX:
+            if (pin->hitbox.count < 0 || pin->hitbox.count > MAX_POLYGON_VERTICES || !IsBoolByteValid(&pin->hitbox.isClosed))
+            {
+                return false;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+// Next chunk header of a mapped file, false if it or its payload runs past the end of the view
+static bool ReadMappedChunkHeader(const unsigned char *view, size_t size, size_t *offset, GraphChunkHeader *chunk)
+{
+    if (*offset > size || size - *offset < sizeof(GraphChunkHeader))
+    {
+        return false;
+    }
+    memcpy(chunk, view + *offset, sizeof(GraphChunkHeader));
+    *offset += sizeof(GraphChunkHeader);
+    return chunk->size >= 0 && (size_t)chunk->size <= size - *offset;
+}
+
+// Points nodes, pins and links at the array chunks of a mapped file without reading them. Only the header, the info
+// chunk and the array sizes are checked here, the arrays themselves are left to VerifyMappedArrays
+static bool UseMappedArrays(const unsigned char *view, size_t size, GraphContext *graph)
+{
+    GraphFileHeader header;
+    if (size < sizeof(GraphFileHeader))
+    {
+        return false;
+    }
+    memcpy(&header, view, sizeof(GraphFileHeader));
+    if (memcmp(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic)) != 0 || header.version < 1 || header.version > GRAPH_FILE_VERSION || !(header.flags & GRAPH_FILE_FLAG_MAPPABLE))
+    {
+        return false;
+    }
+
+    const unsigned char *nodes = NULL, *pins = NULL, *links = NULL;
+    int mappedNodeCount = -1, mappedPinCount = -1, mappedLinkCount = -1;
+    bool hasInfo = false;
+
+    size_t offset = sizeof(GraphFileHeader);
+    for (int i = 0; i < header.chunkCount; i++)
+    {
+        GraphChunkHeader chunk;
+        if (!ReadMappedChunkHeader(view, size, &offset, &chunk))
+        {
+            return false;
+        }
+
+        GraphChunkReader reader = {.data = view + offset, .size = chunk.size};
+        const unsigned char *elements = view + offset + 2 * sizeof(int);
+        int elementSize = 0, elementCount = 0;
+        if (chunk.tag == GRAPH_CHUNK_NODE_ARRAY || chunk.tag == GRAPH_CHUNK_PIN_ARRAY || chunk.tag == GRAPH_CHUNK_LINK_ARRAY)
+        {
+            elementSize = ReadIntFromChunk(&reader);
+            elementCount = ReadIntFromChunk(&reader);
+            if (reader.hasFailed || elementCount < 0 || elementSize <= 0 || (size_t)elementSize * elementCount > (size_t)chunk.size - 2 * sizeof(int))
+            {
+                return false;
+            }
+        }
+
+        switch (chunk.tag)
+        {
+        case GRAPH_CHUNK_INFO:
+            if ((header.flags & GRAPH_FILE_FLAG_CHECKSUMS) && ComputeChecksum(view + offset, chunk.size) != chunk.checksum)
+            {
+                return false;
+            }
+            hasInfo = ReadGraphInfoChunk(&reader, graph);
+            break;
+        case GRAPH_CHUNK_NODE_ARRAY:
+            nodes = elements;
+            mappedNodeCount = elementSize == sizeof(Node) ? elementCount : -1;
+            break;
+        case GRAPH_CHUNK_PIN_ARRAY:
+            pins = elements;
+            mappedPinCount = elementSize == sizeof(Pin) ? elementCount : -1;
+            break;
+        case GRAPH_CHUNK_LINK_ARRAY:
+            links = elements;
+            mappedLinkCount = elementSize == sizeof(Link) ? elementCount : -1;
+            break;
+        default:
+            break;
+        }
+
+        offset += AlignGraphFileSize(chunk.size);
+    }
+
+    if (!hasInfo || !nodes || !pins || !links || mappedNodeCount != graph->nodeCount || mappedPinCount != graph->pinCount || mappedLinkCount != graph->linkCount)
+    {
+        return false;
+    }
+
+    graph->nodes = (Node *)nodes;
+    graph->pins = (Pin *)pins;
+    graph->links = (Link *)links;
+    graph->isMappingVerified = false;
+    return true;
+}
+
+static bool AreMappedArrayChecksumsValid(const unsigned char *view, size_t size)
+{
+    GraphFileHeader header;
+    memcpy(&header, view, sizeof(GraphFileHeader));
+    if (!(header.flags & GRAPH_FILE_FLAG_CHECKSUMS))
+    {
+        return true;
+    }
+
+    size_t offset = sizeof(GraphFileHeader);
+    for (int i = 0; i < header.chunkCount; i++)
+    {
+        GraphChunkHeader chunk;
+        if (!ReadMappedChunkHeader(view, size, &offset, &chunk))
+        {
+            return false;
+        }
+
+        bool isArray = chunk.tag == GRAPH_CHUNK_NODE_ARRAY || chunk.tag == GRAPH_CHUNK_PIN_ARRAY || chunk.tag == GRAPH_CHUNK_LINK_ARRAY;
+        if (isArray && ComputeChecksum(view + offset, chunk.size) != chunk.checksum)
+        {
+            return false;
+        }
+
+        offset += AlignGraphFileSize(chunk.size);
+    }
+    return true;
+}
+
+// Decodes the regular chunks of a mapped file into their own allocations, for when its arrays turn out to be damaged
+static bool DecodeMappedGraph(const unsigned char *view, size_t size, GraphContext *graph)
+{
+    GraphFileHeader header;
+    memcpy(&header, view, sizeof(GraphFileHeader));
+
+    DecodedGraphChunks decoded = {0};
+    bool isValid = true;
+
+    size_t offset = sizeof(GraphFileHeader);
+    for (int i = 0; i < header.chunkCount && isValid; i++)
+    {
+        GraphChunkHeader chunk;
+        if (!ReadMappedChunkHeader(view, size, &offset, &chunk))
+        {
+            isValid = false;
+            break;
+        }
+
+        if (!IsDecodedGraphChunk(chunk.tag))
+        {
+            offset += AlignGraphFileSize(chunk.size);
+            continue;
+        }
+
+        if ((header.flags & GRAPH_FILE_FLAG_CHECKSUMS) && ComputeChecksum(view + offset, chunk.size) != chunk.checksum)
+        {
+            isValid = false;
+            break;
+        }
+
+        GraphChunkReader reader = {.data = view + offset, .size = chunk.size};
+        isValid = DecodeGraphChunk(chunk.tag, &reader, graph, &decoded);
+
+        offset += AlignGraphFileSize(chunk.size);
     }
 
-    if (graph->links)
+    return isValid && decoded.hasInfo && decoded.hasNodes && decoded.hasPins && decoded.hasLinks;
+}
+
+static bool LoadMappedGraph(const char *filename, GraphContext *graph)
+{
+    size_t size;
+    unsigned char *view = MapGraphFile(filename, &size);
+    if (!view)
     {
-        free(graph->links);
-        graph->links = NULL;
+        return false;
     }
 
-    if (graph->nodes)
+    if (!UseMappedArrays(view, size, graph))
     {
-        free(graph->nodes);
-        graph->nodes = NULL;
+        graph->mappedView = view;
+        graph->mappedSize = size;
+        UnmapGraphFile(graph);
+        return false;
     }
 
-    graph->nodeCount = 0;
-    graph->nextNodeID = 0;
-    graph->pinCount = 0;
-    graph->nextPinID = 0;
-    graph->linkCount = 0;
-    graph->nextLinkID = 0;
+    graph->mappedView = view;
+    graph->mappedSize = size;
+    return true;
 }
 
-int FindPinIndexByID(GraphContext *graph, int id)
+// Names are read with a bound, since the nodes of a mapped file are not verified yet
+static void CollectGraphVariables(GraphContext *graph)
 {
-    for (int i = 0; i < graph->pinCount; i++)
+    graph->variables = malloc(sizeof(char *) * 1);
+    graph->variableTypes = malloc(sizeof(NodeType) * 1);
+    graph->variables[0] = strmac(NULL, 5, "NONE");
+    graph->variableTypes[0] = NODE_UNKNOWN;
+    graph->variablesCount = 1;
+
+    for (int i = 1; i < graph->nodeCount; i++)
     {
-        if (graph->pins[i].id == id)
+        if (graph->nodes[i].type == NODE_CREATE_NUMBER || graph->nodes[i].type == NODE_CREATE_STRING || graph->nodes[i].type == NODE_CREATE_BOOL || graph->nodes[i].type == NODE_CREATE_COLOR || graph->nodes[i].type == NODE_CREATE_SPRITE)
         {
-            return i;
+            graph->variables = realloc(graph->variables, sizeof(char *) * (graph->variablesCount + 1));
+            graph->variables[graph->variablesCount] = strmac(NULL, MAX_VARIABLE_NAME_SIZE, "%.*s", MAX_VARIABLE_NAME_SIZE - 1, graph->nodes[i].name);
+
+            graph->variableTypes = realloc(graph->variableTypes, sizeof(int) * (graph->variablesCount + 1));
+            graph->variableTypes[graph->variablesCount] = graph->nodes[i].type;
+
+            graph->variablesCount++;
         }
     }
-    return -1;
 }
 
-int SaveGraphToFile(const char *filename, GraphContext *graph)
+static void FreeGraphVariables(GraphContext *graph)
 {
-    FILE *file = fopen(filename, "wb");
-    if (!file)
+    for (int i = 0; i < graph->variablesCount; i++)
     {
-        return 1;
+        free(graph->variables[i]);
+    }
+    free(graph->variables);
+    free(graph->variableTypes);
+    graph->variables = NULL;
+    graph->variableTypes = NULL;
+    graph->variablesCount = 0;
+}
+
+bool VerifyMappedArrays(GraphContext *graph)
+{
+    if (!graph->mappedView || graph->isMappingVerified)
+    {
+        return true;
+    }
+
+    if (AreMappedArrayChecksumsValid(graph->mappedView, graph->mappedSize) && AreMappedNodesValid(graph->nodes, graph->nodeCount) && AreMappedPinsValid(graph->pins, graph->pinCount))
+    {
+        graph->isMappingVerified = true;
+        return true;
     }
 
-    fwrite(&graph->nextNodeID, sizeof(int), 1, file);
-    fwrite(&graph->nextPinID, sizeof(int), 1, file);
-    fwrite(&graph->nextLinkID, sizeof(int), 1, file);
+    GraphContext decoded = InitGraphContext();
+    bool isDecoded = DecodeMappedGraph(graph->mappedView, graph->mappedSize, &decoded);
+    if (!isDecoded)
+    {
+        free(decoded.nodes);
+        free(decoded.pins);
+        free(decoded.links);
+        decoded = InitGraphContext();
+    }
 
-    fwrite(&graph->nodeCount, sizeof(int), 1, file);
-    fwrite(graph->nodes, sizeof(Node), graph->nodeCount, file);
+    UnmapGraphFile(graph);
 
-    fwrite(&graph->pinCount, sizeof(int), 1, file);
-    fwrite(graph->pins, sizeof(Pin), graph->pinCount, file);
+    graph->nodes = decoded.nodes;
+    graph->nodeCount = decoded.nodeCount;
+    graph->nextNodeID = decoded.nextNodeID;
+    graph->pins = decoded.pins;
+    graph->pinCount = decoded.pinCount;
+    graph->nextPinID = decoded.nextPinID;
+    graph->links = decoded.links;
+    graph->linkCount = decoded.linkCount;
+    graph->nextLinkID = decoded.nextLinkID;
 
-    fwrite(&graph->linkCount, sizeof(int), 1, file);
-    fwrite(graph->links, sizeof(Link), graph->linkCount, file);
+    FreeIDIndexMap(&graph->pinIndexByID);
+    FreeIDIndexMap(&graph->nodeIndexByID);
+    FreeNodeGrid(&graph->nodeGrid);
+    graph->isDrawCacheValid = false;
 
-    fclose(file);
+    FreeGraphVariables(graph);
+    CollectGraphVariables(graph);
 
-    return 0;
+    return isDecoded;
 }
 
-bool LoadGraphFromFile(const char *filename, GraphContext *graph)
+static bool LoadLegacyGraph(FILE *file, GraphContext *graph)
 {
-    FILE *file = fopen(filename, "rb");
-    if (!file)
-    {
-        return false;
-    }
-
     (void)fread(&graph->nextNodeID, sizeof(int), 1, file);
     (void)fread(&graph->nextPinID, sizeof(int), 1, file);
     (void)fread(&graph->nextLinkID, sizeof(int), 1, file);
@@ -115,30 +1570,55 @@ bool LoadGraphFromFile(const char *filename, GraphContext *graph)
     graph->links = malloc(sizeof(Link) * graph->linkCount);
     (void)fread(graph->links, sizeof(Link), graph->linkCount, file);
 
-    fclose(file);
+    return true;
+}
 
-    graph->variables = NULL;
+bool LoadGraphFromFile(const char *filename, GraphContext *graph)
+{
+    FILE *file = fopen(filename, "rb");
+    if (!file)
+    {
+        return false;
+    }
 
-    graph->variables = malloc(sizeof(char *) * 1);
-    graph->variableTypes = malloc(sizeof(NodeType) * 1);
-    graph->variables[0] = strmac(NULL, 5, "NONE");
-    graph->variableTypes[0] = NODE_UNKNOWN;
-    graph->variablesCount = 1;
+    GraphFileHeader header;
+    bool isChunked = fread(&header, sizeof(GraphFileHeader), 1, file) == 1 && memcmp(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic)) == 0;
+    rewind(file);
 
-    for (int i = 1; i < graph->nodeCount; i++)
+    bool isLoaded;
+    if (isChunked && (header.flags & GRAPH_FILE_FLAG_MAPPABLE) && LoadMappedGraph(filename, graph))
     {
-        if (graph->nodes[i].type == NODE_CREATE_NUMBER || graph->nodes[i].type == NODE_CREATE_STRING || graph->nodes[i].type == NODE_CREATE_BOOL || graph->nodes[i].type == NODE_CREATE_COLOR || graph->nodes[i].type == NODE_CREATE_SPRITE)
-        {
-            graph->variables = realloc(graph->variables, sizeof(char *) * (graph->variablesCount + 1));
-            graph->variables[graph->variablesCount] = strmac(NULL, MAX_VARIABLE_NAME_SIZE, graph->nodes[i].name);
+        isLoaded = true;
+    }
+    else
+    {
+        isLoaded = isChunked ? LoadChunkedGraph(file, graph) : LoadLegacyGraph(file, graph);
+    }
 
-            graph->variableTypes = realloc(graph->variableTypes, sizeof(int) * (graph->variablesCount + 1));
-            graph->variableTypes[graph->variablesCount] = graph->nodes[i].type;
+    fclose(file);
 
-            graph->variablesCount++;
-        }
+    if (!isLoaded)
+    {
+        free(graph->nodes);
+        free(graph->pins);
+        free(graph->links);
+        graph->nodes = NULL;
+        graph->pins = NULL;
+        graph->links = NULL;
+        graph->nodeCount = 0;
+        graph->pinCount = 0;
+        graph->linkCount = 0;
+        return false;
     }
 
+    // Rebuilt on the first lookup, so a mapped graph is not read in full here
+    FreeIDIndexMap(&graph->pinIndexByID);
+    FreeIDIndexMap(&graph->nodeIndexByID);
+    FreeNodeGrid(&graph->nodeGrid);
+    graph->isDrawCacheValid = false;
+
+    CollectGraphVariables(graph);
+
     return true;
 }
 
@@ -200,6 +1680,11 @@ char *AssignAvailableVarName(GraphContext *graph, const char *baseName)
 
 bool CreateNode(GraphContext *graph, NodeType type, Vector2 pos)
 {
+    if (!DetachMappedArrays(graph))
+    {
+        return false;
+    }
+
     Node node = {0};
     node.id = graph->nextNodeID++;
     node.type = type;
@@ -258,6 +1743,7 @@ bool CreateNode(GraphContext *graph, NodeType type, Vector2 pos)
         Pin pin = CreatePin(graph, node.id, true, getInputsByType(type)[i], i, (Vector2){0, 0});
         graph->pins[graph->pinCount] = pin;
         node.inputPins[node.inputCount++] = pin.id;
+        IndexAppendedID(&graph->pinIndexByID, pin.id, graph->pinCount);
         graph->pinCount++;
     }
 
@@ -266,6 +1752,7 @@ bool CreateNode(GraphContext *graph, NodeType type, Vector2 pos)
         Pin pin = CreatePin(graph, node.id, false, getOutputsByType(type)[i], i, (Vector2){0, 0});
         graph->pins[graph->pinCount] = pin;
         node.outputPins[node.outputCount++] = pin.id;
+        IndexAppendedID(&graph->pinIndexByID, pin.id, graph->pinCount);
         graph->pinCount++;
     }
 
@@ -275,23 +1762,26 @@ bool CreateNode(GraphContext *graph, NodeType type, Vector2 pos)
         return false;
     }
     graph->nodes = newNodes;
+    IndexAppendedID(&graph->nodeIndexByID, node.id, graph->nodeCount);
     graph->nodes[graph->nodeCount++] = node;
+    IndexAppendedNode(graph);
+    graph->isDrawCacheValid = false;
 
     return true;
 }
 
 int GetPinIndexByID(int id, GraphContext *graph)
 {
-    for (int i = 0; i < graph->pinCount; i++)
-    {
-        if (graph->pins[i].id == id)
-            return i;
-    }
-    return -1;
+    return FindPinIndexByID(graph, id);
 }
 
 bool DuplicateNode(GraphContext *graph, const Node *src, Vector2 pos, int nodeY)
 {
+    if (!DetachMappedArrays(graph))
+    {
+        return false;
+    }
+
     Node node = {0};
     node.id = graph->nextNodeID++;
     node.type = src->type;
@@ -340,6 +1830,7 @@ bool DuplicateNode(GraphContext *graph, const Node *src, Vector2 pos, int nodeY)
 
         graph->pins[graph->pinCount] = pin;
         node.inputPins[node.inputCount++] = pin.id;
+        IndexAppendedID(&graph->pinIndexByID, pin.id, graph->pinCount);
         graph->pinCount++;
     }
 
@@ -360,6 +1851,7 @@ bool DuplicateNode(GraphContext *graph, const Node *src, Vector2 pos, int nodeY)
 
         graph->pins[graph->pinCount] = pin;
         node.outputPins[node.outputCount++] = pin.id;
+        IndexAppendedID(&graph->pinIndexByID, pin.id, graph->pinCount);
         graph->pinCount++;
     }
 
@@ -369,7 +1861,10 @@ bool DuplicateNode(GraphContext *graph, const Node *src, Vector2 pos, int nodeY)
         return false;
     }
     graph->nodes = newNodes;
+    IndexAppendedID(&graph->nodeIndexByID, node.id, graph->nodeCount);
     graph->nodes[graph->nodeCount++] = node;
+    IndexAppendedNode(graph);
+    graph->isDrawCacheValid = false;
 
     return true;
 }
@@ -389,6 +1884,11 @@ void CreateLink(GraphContext *graph, Pin Pin1, Pin Pin2)
         return;
     }
 
+    if (!DetachMappedArrays(graph))
+    {
+        return;
+    }
+
     Link link = {0};
 
     if (Pin1.isInput)
@@ -432,6 +1932,7 @@ void CreateLink(GraphContext *graph, Pin Pin1, Pin Pin2)
 
     graph->links = realloc(graph->links, sizeof(Link) * (graph->linkCount + 1));
     graph->links[graph->linkCount++] = link;
+    graph->isDrawCacheValid = false;
 }
 
 void DeleteNode(GraphContext *graph, int nodeID)
@@ -439,15 +1940,10 @@ void DeleteNode(GraphContext *graph, int nodeID)
     if (graph->nodeCount == 0)
         return;
 
-    int nodeIndex = -1;
-    for (int i = 0; i < graph->nodeCount; i++)
-    {
-        if (graph->nodes[i].id == nodeID)
-        {
-            nodeIndex = i;
-            break;
-        }
-    }
+    if (!DetachMappedArrays(graph))
+        return;
+
+    int nodeIndex = FindNodeIndexByID(graph, nodeID);
     if (nodeIndex == -1)
     {
         return;
@@ -476,18 +1972,16 @@ void DeleteNode(GraphContext *graph, int nodeID)
         {
             if (graph->nodes[i].type == NODE_GET_VARIABLE || graph->nodes[i].type == NODE_SET_VARIABLE)
             {
-                for (int j = 0; j < graph->pinCount; j++)
+                int j = FindPinIndexByID(graph, graph->nodes[i].inputPins[graph->nodes[i].type == NODE_GET_VARIABLE ? 0 : 1]);
+                if (j != -1)
                 {
-                    if (graph->pins[j].id == graph->nodes[i].inputPins[graph->nodes[i].type == NODE_GET_VARIABLE ? 0 : 1])
+                    if (graph->pins[j].pickedOption > variableToDeleteIndex)
+                    {
+                        graph->pins[j].pickedOption--;
+                    }
+                    else if (graph->pins[j].pickedOption == variableToDeleteIndex)
                     {
-                        if (graph->pins[j].pickedOption > variableToDeleteIndex)
-                        {
-                            graph->pins[j].pickedOption--;
-                        }
-                        else if (graph->pins[j].pickedOption == variableToDeleteIndex)
-                        {
-                            graph->pins[j].pickedOption = 0;
-                        }
+                        graph->pins[j].pickedOption = 0;
                     }
                 }
             }
@@ -517,6 +2011,10 @@ void DeleteNode(GraphContext *graph, int nodeID)
         graph->variableTypes = realloc(graph->variableTypes, graph->variablesCount * sizeof(NodeType));
     }
 
+    graph->isDrawCacheValid = false;
+
+    UnindexSwapRemovedNode(graph, nodeIndex);
+    UnindexSwapRemovedID(&graph->nodeIndexByID, nodeID, graph->nodes[graph->nodeCount - 1].id, nodeIndex, graph->nodeCount);
     graph->nodes[nodeIndex] = graph->nodes[graph->nodeCount - 1];
     graph->nodeCount--;
 
@@ -540,6 +2038,7 @@ void DeleteNode(GraphContext *graph, int nodeID)
         if (graph->pins[i].nodeID == nodeID)
         {
             pinsToDelete[pinsToDeleteCount++] = graph->pins[i].id;
+            UnindexSwapRemovedID(&graph->pinIndexByID, graph->pins[i].id, graph->pins[graph->pinCount - 1].id, i, graph->pinCount);
             graph->pins[i] = graph->pins[graph->pinCount - 1];
             graph->pinCount--;
 
@@ -604,6 +2103,11 @@ void DeleteNode(GraphContext *graph, int nodeID)
 
 void RemoveConnections(GraphContext *graph, int pinID)
 {
+    if (!DetachMappedArrays(graph))
+    {
+        return;
+    }
+
     for (int i = 0; i < graph->linkCount;)
     {
         if (graph->links[i].outputPinID == pinID || graph->links[i].inputPinID == pinID)
@@ -616,4 +2120,231 @@ void RemoveConnections(GraphContext *graph, int pinID)
     }
 
     graph->links = realloc(graph->links, sizeof(Link) * graph->linkCount);
-}
\ No newline at end of file
+    graph->isDrawCacheValid = false;
+}
+
+// Only stores positions that changed, so a mapped pin array is not copied page by page when nothing moved
+static void SetPinPosition(Pin *pin, Vector2 position)
+{
+    if (pin->position.x != position.x || pin->position.y != position.y)
+    {
+        pin->position = position;
+    }
+}
+
+void UpdateNodePinPositions(GraphContext *graph, int nodeIndex)
+{
+    Node *node = &graph->nodes[nodeIndex];
+    int outputX = getNodeInfoByType(node->type, INFO_NODE_WIDTH) - 20;
+
+    for (int i = 0; i < node->inputCount; i++)
+    {
+        int pinIndex = FindPinIndexByID(graph, node->inputPins[i]);
+        if (pinIndex != -1)
+        {
+            SetPinPosition(&graph->pins[pinIndex], (Vector2){node->position.x + 10, node->position.y + 52 + graph->pins[pinIndex].posInNode * 30});
+        }
+    }
+
+    for (int i = 0; i < node->outputCount; i++)
+    {
+        int pinIndex = FindPinIndexByID(graph, node->outputPins[i]);
+        if (pinIndex != -1)
+        {
+            SetPinPosition(&graph->pins[pinIndex], (Vector2){node->position.x + outputX + 5, node->position.y + 52 + graph->pins[pinIndex].posInNode * 30});
+        }
+    }
+}
+
+void MoveNode(GraphContext *graph, int nodeIndex, Vector2 delta)
+{
+    graph->nodes[nodeIndex].position.x += delta.x;
+    graph->nodes[nodeIndex].position.y += delta.y;
+    UpdateNodePinPositions(graph, nodeIndex);
+
+    NodeGrid *grid = &graph->nodeGrid;
+    if (!grid->isBuilt)
+    {
+        return;
+    }
+
+    NodeGridRange newRange = GetNodeGridRange(GetNodeRect(&graph->nodes[nodeIndex]), NODE_GRID_MAX_CELLS_PER_NODE);
+    NodeGridRange *range = &grid->rangeByNode[nodeIndex];
+    if (newRange.isOversized == range->isOversized && (newRange.isOversized || (newRange.minX == range->minX && newRange.minY == range->minY && newRange.maxX == range->maxX && newRange.maxY == range->maxY)))
+    {
+        return;
+    }
+
+    RemoveFromNodeGrid(grid, nodeIndex, *range);
+    *range = newRange;
+    if (!InsertIntoNodeGrid(grid, nodeIndex, newRange))
+    {
+        DisableNodeGrid(grid);
+    }
+}
+
+bool UpdateGraphDrawCache(GraphContext *graph)
+{
+    if (graph->isDrawCacheValid)
+    {
+        return true;
+    }
+
+    // Every node and pin is read below, so this is the first bulk access of a mapped graph in the editor
+    VerifyMappedArrays(graph);
+
+    int *nodeIndexByPin = realloc(graph->nodeIndexByPin, sizeof(int) * (graph->pinCount > 0 ? graph->pinCount : 1));
+    if (!nodeIndexByPin)
+    {
+        return false;
+    }
+    graph->nodeIndexByPin = nodeIndexByPin;
+
+    LinkEndpoints *linkEndpoints = realloc(graph->linkEndpoints, sizeof(LinkEndpoints) * (graph->linkCount > 0 ? graph->linkCount : 1));
+    if (!linkEndpoints)
+    {
+        return false;
+    }
+    graph->linkEndpoints = linkEndpoints;
+
+    for (int i = 0; i < graph->pinCount; i++)
+    {
+        graph->nodeIndexByPin[i] = FindNodeIndexByID(graph, graph->pins[i].nodeID);
+    }
+
+    for (int i = 0; i < graph->linkCount; i++)
+    {
+        graph->linkEndpoints[i].inputPinIndex = FindPinIndexByID(graph, graph->links[i].inputPinID);
+        graph->linkEndpoints[i].outputPinIndex = FindPinIndexByID(graph, graph->links[i].outputPinID);
+    }
+
+    // New and loaded nodes get their pin positions here instead of in every frame
+    for (int i = 0; i < graph->nodeCount; i++)
+    {
+        UpdateNodePinPositions(graph, i);
+    }
+
+    graph->isDrawCacheValid = true;
+    return true;
+}
+
+static int CompareNodeIndexes(const void *a, const void *b)
+{
+    return *(const int *)a - *(const int *)b;
+}
+
+static void AddNodeGridCandidates(GraphContext *graph, NodeGridBucket *bucket, Rectangle rect, int *resultCount)
+{
+    NodeGrid *grid = &graph->nodeGrid;
+    for (int i = 0; i < bucket->count; i++)
+    {
+        int nodeIndex = bucket->nodeIndexes[i];
+        if (grid->queryStampByNode[nodeIndex] != grid->queryStamp)
+        {
+            grid->queryStampByNode[nodeIndex] = grid->queryStamp;
+            if (CheckCollisionRecs(rect, GetNodeRect(&graph->nodes[nodeIndex])))
+            {
+                grid->results[(*resultCount)++] = nodeIndex;
+            }
+        }
+    }
+}
+
+int QueryNodesInRect(GraphContext *graph, Rectangle rect)
+{
+    NodeGrid *grid = &graph->nodeGrid;
+
+    if (grid->queryCapacity < graph->nodeCount)
+    {
+        int newCapacity = grid->queryCapacity ? grid->queryCapacity : 64;
+        while (newCapacity < graph->nodeCount)
+        {
+            newCapacity *= 2;
+        }
+
+        int *newResults = realloc(grid->results, sizeof(int) * newCapacity);
+        if (!newResults)
+        {
+            return -1;
+        }
+        grid->results = newResults;
+
+        int *newStamps = calloc(newCapacity, sizeof(int));
+        if (!newStamps)
+        {
+            return -1;
+        }
+        free(grid->queryStampByNode);
+        grid->queryStampByNode = newStamps;
+        grid->queryCapacity = newCapacity;
+        grid->queryStamp = 0;
+    }
+
+    if (!grid->isBuilt && (grid->hasFailed || !BuildNodeGrid(graph)))
+    {
+        int resultCount = 0;
+        for (int i = 0; i < graph->nodeCount; i++)
+        {
+            if (CheckCollisionRecs(rect, GetNodeRect(&graph->nodes[i])))
+            {
+                grid->results[resultCount++] = i;
+            }
+        }
+        return resultCount;
+    }
+
+    if (grid->queryStamp == INT_MAX)
+    {
+        memset(grid->queryStampByNode, 0, sizeof(int) * grid->queryCapacity);
+        grid->queryStamp = 0;
+    }
+    grid->queryStamp++;
+
+    int resultCount = 0;
+    AddNodeGridCandidates(graph, &grid->oversized, rect, &resultCount);
+
+    // A rect covering more cells than there are buckets visits every bucket once instead
+    NodeGridRange range = GetNodeGridRange(rect, NODE_GRID_BUCKET_COUNT);
+    if (range.isOversized)
+    {
+        for (int i = 0; i < NODE_GRID_BUCKET_COUNT; i++)
+        {
+            AddNodeGridCandidates(graph, &grid->buckets[i], rect, &resultCount);
+        }
+    }
+    else
+    {
+        for (int y = range.minY; y <= range.maxY; y++)
+        {
+            for (int x = range.minX; x <= range.maxX; x++)
+            {
+                AddNodeGridCandidates(graph, GetNodeGridBucket(grid, x, y), rect, &resultCount);
+            }
+        }
+    }
+
+    // Same order as a full scan, so overlapping nodes are drawn and picked as before
+    qsort(grid->results, resultCount, sizeof(int), CompareNodeIndexes);
+    return resultCount;
+}
+
+int QueryNodesAtPoint(GraphContext *graph, Vector2 point)
+{
+    int candidateCount = QueryNodesInRect(graph, (Rectangle){point.x - 1, point.y - 1, 2, 2});
+    if (candidateCount == -1)
+    {
+        return -1;
+    }
+
+    // The rect test leaves out the left and top edges, so the candidates come from a slightly bigger rect
+    int resultCount = 0;
+    for (int i = 0; i < candidateCount; i++)
+    {
+        int nodeIndex = graph->nodeGrid.results[i];
+        if (CheckCollisionPointRec(point, GetNodeRect(&graph->nodes[nodeIndex])))
+        {
+            graph->nodeGrid.results[resultCount++] = nodeIndex;
+        }
+    }
+    return resultCount;
+}
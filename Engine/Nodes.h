@@ -57,6 +57,111 @@ typedef struct Link
 
 #define INVALID_PIN (Pin){-1}
 
+// Pin indexes of a link, -1 when the pin is missing
+typedef struct LinkEndpoints
+{
+    int inputPinIndex;
+    int outputPinIndex;
+} LinkEndpoints;
+
+// Open addressing map from pin or node ID to its index in the graph arrays
+typedef struct IDIndexMap
+{
+    int *ids;
+    int *indexes;
+    int capacity;
+    int count;
+} IDIndexMap;
+
+#define NODE_GRID_CELL_SIZE 256.0f
+#define NODE_GRID_BUCKET_COUNT 1024
+#define NODE_GRID_MAX_CELLS_PER_NODE 16
+
+typedef struct NodeGridBucket
+{
+    int *nodeIndexes;
+    int count;
+    int capacity;
+} NodeGridBucket;
+
+// Cells covered by a node, nodes covering too many cells are kept in the oversized bucket
+typedef struct NodeGridRange
+{
+    int minX;
+    int minY;
+    int maxX;
+    int maxY;
+    bool isOversized;
+} NodeGridRange;
+
+// Spatial hash over node rectangles for the editor, built on the first query and then kept up to date
+// as nodes are created, moved and deleted
+typedef struct NodeGrid
+{
+    NodeGridBucket *buckets;
+    NodeGridBucket oversized;
+    NodeGridRange *rangeByNode;
+    int rangeCapacity;
+
+    // Filled by the queries, sorted by node index
+    int *results;
+    int *queryStampByNode;
+    int queryCapacity;
+    int queryStamp;
+
+    bool isBuilt;
+    // Queries scan every node instead, until the graph is loaded again
+    bool hasFailed;
+} NodeGrid;
+
+// A .cg file is a GraphFileHeader followed by chunks. Every chunk is a GraphChunkHeader and a payload
+// padded to GRAPH_FILE_ALIGNMENT. Values are written in native byte order, little-endian on every supported platform.
+// Files without the magic are read as the legacy format of raw Node, Pin and Link structs
+#define GRAPH_FILE_MAGIC "RPCG"
+#define GRAPH_FILE_VERSION 1
+#define GRAPH_FILE_ALIGNMENT 8
+
+#define GRAPH_FILE_FLAG_CHECKSUMS 1
+// The file also has the array chunks below, so LoadGraphFromFile can map it and use them in place
+#define GRAPH_FILE_FLAG_MAPPABLE 2
+
+// Graphs with at least this many nodes are saved with array chunks as well
+#define GRAPH_FILE_MAPPED_MIN_NODES 4096
+
+#define GRAPH_CHUNK_TAG(a, b, c, d) ((unsigned int)(a) | ((unsigned int)(b) << 8) | ((unsigned int)(c) << 16) | ((unsigned int)(d) << 24))
+
+// next IDs and element counts, always the first chunk so the others can be read into pre-sized arrays
+#define GRAPH_CHUNK_INFO GRAPH_CHUNK_TAG('I', 'N', 'F', 'O')
+// id, type, position, pin counts, pin IDs and the length-prefixed name of every node
+#define GRAPH_CHUNK_NODES GRAPH_CHUNK_TAG('N', 'O', 'D', 'E')
+// id, type, node, position and flags of every pin, then field text, picked option or hitbox depending on the type
+#define GRAPH_CHUNK_PINS GRAPH_CHUNK_TAG('P', 'I', 'N', 'S')
+// input and output pin ID of every link
+#define GRAPH_CHUNK_LINKS GRAPH_CHUNK_TAG('L', 'I', 'N', 'K')
+
+// Element size and count, then the Node, Pin or Link array exactly as it is in memory.
+// Only used when the element size matches this build, otherwise the chunks above are decoded instead
+#define GRAPH_CHUNK_NODE_ARRAY GRAPH_CHUNK_TAG('N', 'O', 'D', 'A')
+#define GRAPH_CHUNK_PIN_ARRAY GRAPH_CHUNK_TAG('P', 'I', 'N', 'A')
+#define GRAPH_CHUNK_LINK_ARRAY GRAPH_CHUNK_TAG('L', 'N', 'K', 'A')
+
+typedef struct
+{
+    char magic[4];
+    int version;
+    int flags;
+    int chunkCount;
+} GraphFileHeader;
+
+// Chunks with an unknown tag are skipped, so new ones can be added without breaking older readers
+typedef struct
+{
+    unsigned int tag;
+    int size;
+    unsigned int checksum;
+    int reserved;
+} GraphChunkHeader;
+
 typedef struct GraphContext
 {
     Node *nodes;
@@ -74,6 +179,21 @@ typedef struct GraphContext
     char **variables;
     NodeType *variableTypes;
     int variablesCount;
+
+    IDIndexMap pinIndexByID;
+    IDIndexMap nodeIndexByID;
+
+    // Parallel to pins and links, rebuilt by UpdateGraphDrawCache once nodes, pins or links are added or removed
+    int *nodeIndexByPin;
+    LinkEndpoints *linkEndpoints;
+    bool isDrawCacheValid;
+
+    NodeGrid nodeGrid;
+
+    // Set while nodes, pins and links point into a copy-on-write mapping of the loaded file
+    void *mappedView;
+    size_t mappedSize;
+    bool isMappingVerified;
 } GraphContext;
 
 GraphContext InitGraphContext();
@@ -86,6 +206,10 @@ int SaveGraphToFile(const char *filename, GraphContext *graph);
 
 bool LoadGraphFromFile(const char *filename, GraphContext *graph);
 
+// Checksums and validates mapped arrays once, before they are read in bulk or written. Damaged arrays are replaced
+// by the decoded chunks of the same file, false if those are damaged too and the graph was left empty
+bool VerifyMappedArrays(GraphContext *graph);
+
 Pin CreatePin(GraphContext *graph, int nodeID, bool isInput, PinType type, int index, Vector2 pos);
 
 bool CreateNode(GraphContext *graph, NodeType type, Vector2 pos);
@@ -98,4 +222,21 @@ void DeleteNode(GraphContext *graph, int nodeID);
 
 int FindPinIndexByID(GraphContext *graph, int id);
 
-void RemoveConnections(GraphContext *graph, int pinID);
\ No newline at end of file
+int FindNodeIndexByID(GraphContext *graph, int id);
+
+void RemoveConnections(GraphContext *graph, int pinID);
+
+// Rebuilds the pin to node index, the link endpoints and every pin position if anything was added or removed since the last call
+bool UpdateGraphDrawCache(GraphContext *graph);
+
+// Pin positions are only updated here, call it after moving a node
+void UpdateNodePinPositions(GraphContext *graph, int nodeIndex);
+
+// Moves the node with its pins and updates the node grid
+void MoveNode(GraphContext *graph, int nodeIndex, Vector2 delta);
+
+// Fills graph->nodeGrid.results with the nodes overlapping rect and returns how many, or -1 when out of memory
+int QueryNodesInRect(GraphContext *graph, Rectangle rect);
+
+// Same as QueryNodesInRect for the nodes containing point
+int QueryNodesAtPoint(GraphContext *graph, Vector2 point);
\ No newline at end of file
@@ -0,0 +1,149 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#include "Profiler.h"
+
+#ifdef RAPID_PROFILER
+
+#include <string.h>
+
+bool StartProfiler(Profiler *profiler, Arena *arena, int nodeCount)
+{
+    bool isOn = profiler->isOn;
+    *profiler = (Profiler){0};
+    profiler->isOn = isOn;
+
+    profiler->nodeSeconds = ArenaCalloc(arena, nodeCount + 1, sizeof(double));
+    profiler->nodeExecutionCounts = ArenaCalloc(arena, nodeCount + 1, sizeof(long long));
+    profiler->nodeTypes = ArenaCalloc(arena, nodeCount + 1, sizeof(NodeType));
+    if (!profiler->nodeSeconds || !profiler->nodeExecutionCounts || !profiler->nodeTypes)
+    {
+        return false;
+    }
+
+    profiler->nodeCount = nodeCount;
+    return true;
+}
+
+// Open addressing from node type to its totals, kept at most half full since every type in NodeInfoByType fits
+#define PROFILER_TYPE_SLOT_COUNT (2 * (int)typesCount)
+
+static void UpdateShownNodeTypes(Profiler *profiler)
+{
+    ProfilerNodeTypeStats totals[PROFILER_TYPE_SLOT_COUNT];
+    bool isSlotUsed[PROFILER_TYPE_SLOT_COUNT] = {0};
+
+    for (int i = 0; i < profiler->nodeCount; i++)
+    {
+        if (profiler->nodeExecutionCounts[i] == 0)
+        {
+            continue;
+        }
+
+        NodeType type = profiler->nodeTypes[i];
+        int slot = (int)((unsigned int)type % PROFILER_TYPE_SLOT_COUNT);
+        while (isSlotUsed[slot] && totals[slot].type != type)
+        {
+            slot = (slot + 1) % PROFILER_TYPE_SLOT_COUNT;
+        }
+        if (!isSlotUsed[slot])
+        {
+            isSlotUsed[slot] = true;
+            totals[slot] = (ProfilerNodeTypeStats){.type = type};
+        }
+
+        totals[slot].seconds += profiler->nodeSeconds[i] / profiler->frameCount;
+        totals[slot].executionsPerFrame += (double)profiler->nodeExecutionCounts[i] / profiler->frameCount;
+    }
+
+    // Only the slowest types are shown, picked once every type has its total
+    profiler->shownNodeTypeCount = 0;
+    for (int slot = 0; slot < PROFILER_TYPE_SLOT_COUNT; slot++)
+    {
+        if (!isSlotUsed[slot] || (profiler->shownNodeTypeCount == PROFILER_MAX_NODE_TYPES && totals[slot].seconds <= profiler->shownNodeTypes[PROFILER_MAX_NODE_TYPES - 1].seconds))
+        {
+            continue;
+        }
+
+        int j = profiler->shownNodeTypeCount < PROFILER_MAX_NODE_TYPES ? profiler->shownNodeTypeCount++ : PROFILER_MAX_NODE_TYPES - 1;
+        while (j > 0 && profiler->shownNodeTypes[j - 1].seconds < totals[slot].seconds)
+        {
+            profiler->shownNodeTypes[j] = profiler->shownNodeTypes[j - 1];
+            j--;
+        }
+        profiler->shownNodeTypes[j] = totals[slot];
+    }
+}
+
+static void UpdateHotNodes(Profiler *profiler)
+{
+    profiler->hotNodeCount = 0;
+
+    for (int i = 0; i < profiler->nodeCount; i++)
+    {
+        double seconds = profiler->nodeSeconds[i] / profiler->frameCount;
+        if (profiler->nodeExecutionCounts[i] == 0 || (profiler->hotNodeCount == PROFILER_HOT_NODE_COUNT && seconds <= profiler->hotNodes[PROFILER_HOT_NODE_COUNT - 1].seconds))
+        {
+            continue;
+        }
+
+        int j = profiler->hotNodeCount < PROFILER_HOT_NODE_COUNT ? profiler->hotNodeCount++ : PROFILER_HOT_NODE_COUNT - 1;
+        while (j > 0 && profiler->hotNodes[j - 1].seconds < seconds)
+        {
+            profiler->hotNodes[j] = profiler->hotNodes[j - 1];
+            j--;
+        }
+        profiler->hotNodes[j] = (ProfilerHotNode){.nodeIndex = i, .seconds = seconds, .executionsPerFrame = (double)profiler->nodeExecutionCounts[i] / profiler->frameCount};
+    }
+}
+
+void EndProfilerFrame(Profiler *profiler, float frameTime)
+{
+    if (!profiler->isOn || !profiler->nodeSeconds)
+    {
+        return;
+    }
+
+    profiler->frameSeconds += frameTime;
+    profiler->frameCount++;
+    if (profiler->frameCount < PROFILER_WINDOW_FRAMES)
+    {
+        return;
+    }
+
+    for (int s = 0; s < PROFILER_SECTION_COUNT; s++)
+    {
+        profiler->shownSectionSeconds[s] = profiler->sectionSeconds[s] / profiler->frameCount;
+    }
+    profiler->shownFrameSeconds = profiler->frameSeconds / profiler->frameCount;
+
+    UpdateShownNodeTypes(profiler);
+    UpdateHotNodes(profiler);
+
+    memset(profiler->sectionSeconds, 0, sizeof(profiler->sectionSeconds));
+    memset(profiler->nodeSeconds, 0, sizeof(double) * profiler->nodeCount);
+    memset(profiler->nodeExecutionCounts, 0, sizeof(long long) * profiler->nodeCount);
+    profiler->frameSeconds = 0;
+    profiler->frameCount = 0;
+}
+
+const char *ProfilerSectionToString(ProfilerSection section)
+{
+    switch (section)
+    {
+    case PROFILER_SECTION_EVENTS:
+        return "Events";
+    case PROFILER_SECTION_FORCES:
+        return "Forces";
+    case PROFILER_SECTION_COLLISIONS:
+        return "Collisions";
+    case PROFILER_SECTION_SOUNDS:
+        return "Sounds";
+    case PROFILER_SECTION_DRAW:
+        return "Draw";
+    default:
+        return "Unknown";
+    }
+}
+
+#endif
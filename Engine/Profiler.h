@@ -0,0 +1,113 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <stdbool.h>
+#include "raylib.h"
+#include "InfoByType.h"
+#include "Arena.h"
+
+// Only built into the RapidEngine target when RAPID_PROFILER is defined. Without it the timing macros
+// expand to the bare statement and nothing else here exists
+#ifdef RAPID_PROFILER
+
+// Frames averaged into each update of the overlay, so the numbers can be read while the game runs
+#define PROFILER_WINDOW_FRAMES 30
+#define PROFILER_HOT_NODE_COUNT 5
+#define PROFILER_MAX_NODE_TYPES 16
+
+typedef enum
+{
+    PROFILER_SECTION_EVENTS,
+    PROFILER_SECTION_FORCES,
+    // Also counted in the events and forces that check for collisions
+    PROFILER_SECTION_COLLISIONS,
+    PROFILER_SECTION_SOUNDS,
+    PROFILER_SECTION_DRAW,
+    PROFILER_SECTION_COUNT
+} ProfilerSection;
+
+typedef struct
+{
+    NodeType type;
+    double seconds;
+    double executionsPerFrame;
+} ProfilerNodeTypeStats;
+
+typedef struct
+{
+    int nodeIndex;
+    double seconds;
+    double executionsPerFrame;
+} ProfilerHotNode;
+
+typedef struct
+{
+    // Set from the settings, kept across runs
+    bool isOn;
+
+    // Summed over the frames of the current window
+    double sectionSeconds[PROFILER_SECTION_COUNT];
+    double frameSeconds;
+    // Indexed by runtime node, in the interpreter arena
+    double *nodeSeconds;
+    long long *nodeExecutionCounts;
+    NodeType *nodeTypes;
+    int nodeCount;
+    int frameCount;
+
+    // Per frame averages of the last finished window, this is what the overlay shows
+    double shownSectionSeconds[PROFILER_SECTION_COUNT];
+    double shownFrameSeconds;
+    ProfilerNodeTypeStats shownNodeTypes[PROFILER_MAX_NODE_TYPES];
+    int shownNodeTypeCount;
+    ProfilerHotNode hotNodes[PROFILER_HOT_NODE_COUNT];
+    int hotNodeCount;
+} Profiler;
+
+#define PROFILER_TIME_SECTION(profiler, section, statement)                     \
+    do                                                                          \
+    {                                                                           \
+        if ((profiler)->isOn)                                                   \
+        {                                                                       \
+            double profilerStart = GetTime();                                   \
+            statement;                                                          \
+            (profiler)->sectionSeconds[section] += GetTime() - profilerStart;   \
+        }                                                                       \
+        else                                                                    \
+        {                                                                       \
+            statement;                                                          \
+        }                                                                       \
+    } while (0)
+
+#define PROFILER_TIME_NODE(profiler, nodeIndex, statement)                      \
+    do                                                                          \
+    {                                                                           \
+        if ((profiler)->isOn)                                                   \
+        {                                                                       \
+            double profilerStart = GetTime();                                   \
+            statement;                                                          \
+            (profiler)->nodeSeconds[nodeIndex] += GetTime() - profilerStart;    \
+            (profiler)->nodeExecutionCounts[nodeIndex]++;                       \
+        }                                                                       \
+        else                                                                    \
+        {                                                                       \
+            statement;                                                          \
+        }                                                                       \
+    } while (0)
+
+// Allocates the per node counters for a run, the caller fills in nodeTypes
+bool StartProfiler(Profiler *profiler, Arena *arena, int nodeCount);
+
+// Adds the frame to the window and, once it is full, updates what the overlay shows
+void EndProfilerFrame(Profiler *profiler, float frameTime);
+
+const char *ProfilerSectionToString(ProfilerSection section);
+
+#else
+
+#define PROFILER_TIME_SECTION(profiler, section, statement) statement
+#define PROFILER_TIME_NODE(profiler, nodeIndex, statement) statement
+
+#endif
@@ -0,0 +1,171 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#include <string.h>
+#include "SoundBank.h"
+
+static bool ReserveSounds(SoundBank *bank)
+{
+    if (bank->count >= bank->capacity)
+    {
+        int newCapacity = bank->capacity ? bank->capacity * 2 : SOUND_BANK_INITIAL_CAPACITY;
+        BankedSound *newSounds = realloc(bank->sounds, sizeof(BankedSound) * newCapacity);
+        if (!newSounds)
+        {
+            return false;
+        }
+        bank->sounds = newSounds;
+        bank->capacity = newCapacity;
+    }
+
+    return ReserveHashIndex(&bank->index);
+}
+
+static int FindSound(const SoundBank *bank, const char *path, int length, unsigned int hash)
+{
+    int handle = FindInHashIndex(&bank->index, path, length, hash);
+    return handle == HASH_INDEX_NONE ? SOUND_HANDLE_NONE : handle;
+}
+
+// Takes ownership of sound, it is unloaded if it can't be added
+static int AddSound(SoundBank *bank, Arena *arena, const char *path, int length, unsigned int hash, Sound sound)
+{
+    char *pathCopy = ArenaAlloc(arena, length + 1);
+    if (!pathCopy || !ReserveSounds(bank))
+    {
+        UnloadSound(sound);
+        return SOUND_HANDLE_NONE;
+    }
+    memcpy(pathCopy, path, length + 1);
+
+    int handle = bank->count++;
+    bank->sounds[handle] = (BankedSound){.path = pathCopy, .pathLength = length, .sound = sound};
+
+    InsertIntoHashIndex(&bank->index, pathCopy, length, hash, handle);
+
+    return handle;
+}
+
+int GetBankedSound(SoundBank *bank, Arena *arena, const char *path)
+{
+    if (!path)
+    {
+        return SOUND_HANDLE_NONE;
+    }
+
+    int length = (int)strlen(path);
+    unsigned int hash = HashBytes(path, length);
+
+    int handle = FindSound(bank, path, length, hash);
+    if (handle != SOUND_HANDLE_NONE)
+    {
+        return handle;
+    }
+
+    // Failed loads are not kept so a file added while the game runs is picked up
+    Sound sound = LoadSound(path);
+    if (sound.frameCount == 0 || sound.stream.sampleRate == 0)
+    {
+        UnloadSound(sound);
+        return SOUND_HANDLE_NONE;
+    }
+
+    return AddSound(bank, arena, path, length, hash, sound);
+}
+
+bool PreloadSound(SoundBank *bank, Arena *arena, const char *path, Wave wave)
+{
+    if (!path)
+    {
+        return false;
+    }
+
+    int length = (int)strlen(path);
+    unsigned int hash = HashBytes(path, length);
+
+    if (FindSound(bank, path, length, hash) != SOUND_HANDLE_NONE)
+    {
+        return true;
+    }
+
+    Sound sound = LoadSoundFromWave(wave);
+    if (sound.frameCount == 0 || sound.stream.sampleRate == 0)
+    {
+        UnloadSound(sound);
+        return false;
+    }
+
+    return AddSound(bank, arena, path, length, hash, sound) != SOUND_HANDLE_NONE;
+}
+
+bool PlayBankedSound(SoundBank *bank, int handle)
+{
+    if (handle < 0 || handle >= bank->count)
+    {
+        return false;
+    }
+
+    if (bank->voiceCount >= bank->voiceCapacity)
+    {
+        int newCapacity = bank->voiceCapacity ? bank->voiceCapacity * 2 : SOUND_BANK_INITIAL_VOICE_CAPACITY;
+        SoundVoice *newVoices = realloc(bank->voices, sizeof(SoundVoice) * newCapacity);
+        if (!newVoices)
+        {
+            return false;
+        }
+        bank->voices = newVoices;
+        bank->voiceCapacity = newCapacity;
+    }
+
+    Sound source = bank->sounds[handle].sound;
+    SoundVoice *voice = &bank->voices[bank->voiceCount++];
+    voice->alias = LoadSoundAlias(source);
+    voice->timeLeft = (float)source.frameCount / source.stream.sampleRate;
+
+    SetSoundVolume(voice->alias, bank->volume);
+    PlaySound(voice->alias);
+    return true;
+}
+
+void UpdateSoundVoices(SoundBank *bank, float frameTime)
+{
+    int i = 0;
+    while (i < bank->voiceCount)
+    {
+        bank->voices[i].timeLeft -= frameTime;
+        if (bank->voices[i].timeLeft <= 0)
+        {
+            UnloadSoundAlias(bank->voices[i].alias);
+            bank->voices[i] = bank->voices[--bank->voiceCount];
+            continue;
+        }
+        i++;
+    }
+}
+
+void SetSoundBankVolume(SoundBank *bank, float volume)
+{
+    bank->volume = volume;
+    for (int i = 0; i < bank->voiceCount; i++)
+    {
+        SetSoundVolume(bank->voices[i].alias, volume);
+    }
+}
+
+void FreeSoundBank(SoundBank *bank)
+{
+    // Aliases have to go before the sounds they share samples with
+    for (int i = 0; i < bank->voiceCount; i++)
+    {
+        UnloadSoundAlias(bank->voices[i].alias);
+    }
+    for (int i = 0; i < bank->count; i++)
+    {
+        UnloadSound(bank->sounds[i].sound);
+    }
+
+    free(bank->voices);
+    free(bank->sounds);
+    FreeHashIndex(&bank->index);
+    *bank = (SoundBank){0};
+}
@@ -0,0 +1,68 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "raylib.h"
+#include "Arena.h"
+#include "HashIndex.h"
+
+#define SOUND_BANK_INITIAL_CAPACITY 16
+#define SOUND_BANK_INITIAL_VOICE_CAPACITY 32
+
+// Returned instead of a handle when a sound could not be loaded
+#define SOUND_HANDLE_NONE -1
+
+typedef struct
+{
+    // Full path, in the arena
+    const char *path;
+    int pathLength;
+
+    Sound sound;
+} BankedSound;
+
+// One playing instance, an alias shares the decoded samples of its banked sound
+typedef struct
+{
+    Sound alias;
+    float timeLeft;
+} SoundVoice;
+
+// Every sound file is decoded once per run, playing it only creates an alias. Voices are unordered
+// so a finished one is replaced by the last
+typedef struct
+{
+    BankedSound *sounds;
+    int count;
+    int capacity;
+
+    // From path to handle
+    HashIndex index;
+
+    SoundVoice *voices;
+    int voiceCount;
+    int voiceCapacity;
+
+    // Applied to every voice, including ones started later
+    float volume;
+} SoundBank;
+
+// Decodes the sound on the first request for path, SOUND_HANDLE_NONE if it could not be loaded
+int GetBankedSound(SoundBank *bank, Arena *arena, const char *path);
+
+// Banks an already decoded wave so the first GetBankedSound for path finds it. The wave still belongs to the caller
+bool PreloadSound(SoundBank *bank, Arena *arena, const char *path, Wave wave);
+
+// Starts a new voice of the banked sound, false if there is no memory for it
+bool PlayBankedSound(SoundBank *bank, int handle);
+
+// Releases voices that have finished playing
+void UpdateSoundVoices(SoundBank *bank, float frameTime);
+
+void SetSoundBankVolume(SoundBank *bank, float volume);
+
+// Stops every voice and unloads every sound
+void FreeSoundBank(SoundBank *bank);
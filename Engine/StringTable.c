@@ -0,0 +1,160 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#include <string.h>
+#include "StringTable.h"
+
+static bool ReserveStrings(StringTable *table)
+{
+    if (table->count >= table->capacity)
+    {
+        int newCapacity = table->capacity ? table->capacity * 2 : STRING_TABLE_INITIAL_CAPACITY;
+        InternedString *newStrings = realloc(table->strings, sizeof(InternedString) * newCapacity);
+        if (!newStrings)
+        {
+            return false;
+        }
+        table->strings = newStrings;
+        table->capacity = newCapacity;
+    }
+
+    return true;
+}
+
+static int AddString(StringTable *table, Arena *arena, const char *text, int length, unsigned int hash)
+{
+    if (!ReserveStrings(table) || !ReserveHashIndex(&table->index))
+    {
+        table->hasFailed = true;
+        return -1;
+    }
+
+    char *copy = ArenaAlloc(arena, length + 1);
+    if (!copy)
+    {
+        table->hasFailed = true;
+        return -1;
+    }
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+
+    int id = table->count++;
+    table->strings[id] = (InternedString){.text = copy, .length = length};
+    InsertIntoHashIndex(&table->index, copy, length, hash, id);
+
+    return id;
+}
+
+// The empty string is added first so it always gets STRING_ID_EMPTY
+static bool AddEmptyString(StringTable *table, Arena *arena)
+{
+    return table->count > 0 || AddString(table, arena, "", 0, HashBytes("", 0)) == STRING_ID_EMPTY;
+}
+
+int InternStringWithLength(StringTable *table, Arena *arena, const char *text, int length)
+{
+    if (!AddEmptyString(table, arena))
+    {
+        return STRING_ID_EMPTY;
+    }
+
+    if (!text || length <= 0)
+    {
+        return STRING_ID_EMPTY;
+    }
+
+    unsigned int hash = HashBytes(text, length);
+
+    int id = FindInHashIndex(&table->index, text, length, hash);
+    if (id != HASH_INDEX_NONE)
+    {
+        return id;
+    }
+
+    id = AddString(table, arena, text, length, hash);
+    return id == -1 ? STRING_ID_EMPTY : id;
+}
+
+int InternString(StringTable *table, Arena *arena, const char *text)
+{
+    return InternStringWithLength(table, arena, text, text ? (int)strlen(text) : 0);
+}
+
+int AddOwnedString(StringTable *table, Arena *arena, int capacity)
+{
+    if (!AddEmptyString(table, arena) || capacity <= 0)
+    {
+        return STRING_ID_EMPTY;
+    }
+
+    // Not added to the index, so InternString never hands out an owned string
+    if (!ReserveStrings(table))
+    {
+        table->hasFailed = true;
+        return STRING_ID_EMPTY;
+    }
+
+    char *buffer = ArenaAlloc(arena, capacity);
+    if (!buffer)
+    {
+        table->hasFailed = true;
+        return STRING_ID_EMPTY;
+    }
+    buffer[0] = '\0';
+
+    int id = table->count++;
+    table->strings[id] = (InternedString){.text = buffer, .length = 0, .capacity = capacity};
+    return id;
+}
+
+void SetOwnedString(StringTable *table, int id, const char *text)
+{
+    if (id < 0 || id >= table->count || table->strings[id].capacity == 0)
+    {
+        return;
+    }
+
+    InternedString *str = &table->strings[id];
+    int length = 0;
+    while (length < str->capacity - 1 && text[length] != '\0')
+    {
+        length++;
+    }
+    memcpy(str->text, text, length);
+    str->text[length] = '\0';
+    str->length = length;
+}
+
+int CopyString(StringTable *table, Arena *arena, int id)
+{
+    if (id < 0 || id >= table->count || table->strings[id].capacity == 0)
+    {
+        return id;
+    }
+    return InternStringWithLength(table, arena, table->strings[id].text, table->strings[id].length);
+}
+
+const char *GetInternedString(const StringTable *table, int id)
+{
+    if (id < 0 || id >= table->count)
+    {
+        return "";
+    }
+    return table->strings[id].text;
+}
+
+int GetInternedStringLength(const StringTable *table, int id)
+{
+    if (id < 0 || id >= table->count)
+    {
+        return 0;
+    }
+    return table->strings[id].length;
+}
+
+void FreeStringTable(StringTable *table)
+{
+    free(table->strings);
+    FreeHashIndex(&table->index);
+    *table = (StringTable){0};
+}
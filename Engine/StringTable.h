@@ -0,0 +1,59 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "Arena.h"
+#include "HashIndex.h"
+
+#define STRING_TABLE_INITIAL_CAPACITY 64
+
+// Always the empty string, so zeroed values hold a valid string
+#define STRING_ID_EMPTY 0
+
+typedef struct
+{
+    char *text;
+    int length;
+    // Size of the text buffer for owned strings, 0 for interned ones
+    int capacity;
+} InternedString;
+
+// Every distinct string is stored once and never changes, so equal strings always have the same ID
+// and comparing IDs compares contents. Owned strings are the exception, they are not in the index and are
+// rewritten in place, so values that change every run don't add a string each time.
+// The text is kept in an arena, the table itself on the heap
+typedef struct
+{
+    InternedString *strings;
+    int count;
+    int capacity;
+
+    // From contents to string ID, owned strings are left out
+    HashIndex index;
+
+    // Set when a string could not be added, InternString then returns STRING_ID_EMPTY
+    bool hasFailed;
+} StringTable;
+
+int InternString(StringTable *table, Arena *arena, const char *text);
+
+int InternStringWithLength(StringTable *table, Arena *arena, const char *text, int length);
+
+// Adds a string with room for capacity - 1 characters that SetOwnedString can rewrite, STRING_ID_EMPTY if out of memory
+int AddOwnedString(StringTable *table, Arena *arena, int capacity);
+
+// Does nothing for IDs that are not owned strings, text that does not fit is cut off
+void SetOwnedString(StringTable *table, int id, const char *text);
+
+// Interned copy of an owned string, so the copy keeps its text when the owned string is rewritten.
+// Any other ID already never changes and is returned as it is
+int CopyString(StringTable *table, Arena *arena, int id);
+
+const char *GetInternedString(const StringTable *table, int id);
+
+int GetInternedStringLength(const StringTable *table, int id);
+
+void FreeStringTable(StringTable *table);
@@ -0,0 +1,136 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#include <string.h>
+#include "TextureCache.h"
+
+static bool ReserveTextures(TextureCache *cache)
+{
+    if (cache->count >= cache->capacity)
+    {
+        int newCapacity = cache->capacity ? cache->capacity * 2 : TEXTURE_CACHE_INITIAL_CAPACITY;
+        CachedTexture *newTextures = realloc(cache->textures, sizeof(CachedTexture) * newCapacity);
+        if (!newTextures)
+        {
+            return false;
+        }
+        cache->textures = newTextures;
+        cache->capacity = newCapacity;
+    }
+
+    return ReserveHashIndex(&cache->index);
+}
+
+static int FindTexture(const TextureCache *cache, const char *path, int length, unsigned int hash)
+{
+    int handle = FindInHashIndex(&cache->index, path, length, hash);
+    return handle == HASH_INDEX_NONE ? TEXTURE_HANDLE_NONE : handle;
+}
+
+// Takes ownership of texture, it is unloaded if it can't be added
+static int AddTexture(TextureCache *cache, Arena *arena, const char *path, int length, unsigned int hash, Texture2D texture)
+{
+    char *pathCopy = ArenaAlloc(arena, length + 1);
+    if (!pathCopy || !ReserveTextures(cache))
+    {
+        if (texture.id != 0)
+        {
+            UnloadTexture(texture);
+        }
+        return TEXTURE_HANDLE_NONE;
+    }
+    memcpy(pathCopy, path, length + 1);
+
+    int handle = cache->count++;
+    cache->textures[handle] = (CachedTexture){.path = pathCopy, .pathLength = length, .texture = texture};
+
+    InsertIntoHashIndex(&cache->index, pathCopy, length, hash, handle);
+
+    return handle;
+}
+
+int AcquireTexture(TextureCache *cache, Arena *arena, const char *path)
+{
+    if (!path)
+    {
+        return TEXTURE_HANDLE_NONE;
+    }
+
+    int length = (int)strlen(path);
+    unsigned int hash = HashBytes(path, length);
+
+    int handle = FindTexture(cache, path, length, hash);
+    if (handle != TEXTURE_HANDLE_NONE)
+    {
+        cache->hits++;
+        return cache->textures[handle].texture.id == 0 ? TEXTURE_HANDLE_NONE : handle;
+    }
+
+    cache->misses++;
+
+    // A failed load is cached too, as an entry without a texture, so a missing file is only looked for once per run
+    Texture2D texture = LoadTexture(path);
+    handle = AddTexture(cache, arena, path, length, hash, texture);
+    if (handle != TEXTURE_HANDLE_NONE && texture.id == 0)
+    {
+        cache->failures++;
+    }
+    return texture.id == 0 ? TEXTURE_HANDLE_NONE : handle;
+}
+
+bool PreloadTexture(TextureCache *cache, Arena *arena, const char *path, Image image)
+{
+    if (!path)
+    {
+        return false;
+    }
+
+    int length = (int)strlen(path);
+    unsigned int hash = HashBytes(path, length);
+
+    int handle = FindTexture(cache, path, length, hash);
+    if (handle != TEXTURE_HANDLE_NONE && cache->textures[handle].texture.id != 0)
+    {
+        return true;
+    }
+
+    Texture2D texture = LoadTextureFromImage(image);
+    if (texture.id == 0)
+    {
+        return false;
+    }
+
+    // Fills in an earlier failed load of the same path
+    if (handle != TEXTURE_HANDLE_NONE)
+    {
+        cache->textures[handle].texture = texture;
+        cache->failures--;
+        return true;
+    }
+
+    return AddTexture(cache, arena, path, length, hash, texture) != TEXTURE_HANDLE_NONE;
+}
+
+Texture2D GetCachedTexture(const TextureCache *cache, int handle)
+{
+    if (handle < 0 || handle >= cache->count)
+    {
+        return (Texture2D){0};
+    }
+    return cache->textures[handle].texture;
+}
+
+void FreeTextureCache(TextureCache *cache)
+{
+    for (int i = 0; i < cache->count; i++)
+    {
+        if (cache->textures[i].texture.id != 0)
+        {
+            UnloadTexture(cache->textures[i].texture);
+        }
+    }
+
+    free(cache->textures);
+    FreeHashIndex(&cache->index);
+    *cache = (TextureCache){0};
+}
@@ -0,0 +1,54 @@
+// Copyright 2025 Emil Dimov
+// Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "raylib.h"
+#include "Arena.h"
+#include "HashIndex.h"
+
+#define TEXTURE_CACHE_INITIAL_CAPACITY 16
+
+// Returned instead of a handle when a texture could not be loaded
+#define TEXTURE_HANDLE_NONE -1
+
+typedef struct
+{
+    // Full path, in the arena
+    const char *path;
+    int pathLength;
+
+    Texture2D texture;
+} CachedTexture;
+
+// Per run cache from path to texture. Every texture file is loaded once per run and shared by all sprites using it.
+// Nothing is unloaded before FreeTextureCache at the end of the run, whether sprites still use it or not, so swapping
+// between animation frames never goes back to disk and sprites need no bookkeeping when they change or drop a texture.
+// Paths that failed to load are kept with a zero texture, so they are not retried until the next run
+typedef struct
+{
+    CachedTexture *textures;
+    int count;
+    int capacity;
+
+    // From path to handle
+    HashIndex index;
+
+    int hits;
+    int misses;
+    // Entries without a texture, counted in count as well
+    int failures;
+} TextureCache;
+
+// Loads the texture on the first request for path, TEXTURE_HANDLE_NONE if it could not be loaded
+int AcquireTexture(TextureCache *cache, Arena *arena, const char *path);
+
+// Uploads an already decoded image so the first AcquireTexture for path is a hit. The image still belongs to the caller
+bool PreloadTexture(TextureCache *cache, Arena *arena, const char *path, Image image);
+
+Texture2D GetCachedTexture(const TextureCache *cache, int handle);
+
+// Unloads every texture, called once the run is over
+void FreeTextureCache(TextureCache *cache);
@@ -10,6 +10,10 @@
 #include "raylib.h"
 #include "resources/resources.h"
 
+#ifdef RAPID_HEADLESS
+#include "Headless.h"
+#endif
+
 #define FPS_DEFAULT 60
 #define FPS_HIGH 140
 
@@ -165,6 +169,8 @@ extern const char *AddEllipsis(Font font, const char *text, float fontSize, floa
 #define COLOR_TE_OPTIONS_MENU_ITEM_HOVER (Color){255, 255, 255, 50}
 
 #define COLOR_INTP_PAUSE_BLUR (Color){80, 80, 80, 50}
+#define COLOR_INTP_PROFILER_BACKGROUND (Color){20, 20, 20, 200}
+#define COLOR_INTP_PROFILER_ROW_HOVER (Color){255, 255, 255, 40}
 
 #define COLOR_CGED_WIRE_FLOW (Color){180, 100, 200, 255}
 #define COLOR_CGED_WIRE_NUM (Color){24, 119, 149, 255}